@@ -0,0 +1,125 @@
+/*
+ NMEA0183 library. Field parser benchmark
+   Checks NMEA0183FieldToDouble, NMEA0183FieldToLatLon and NMEA0183FieldToSeconds
+   against atof based parsing and compares their speed with atof.
+
+   First random decimal strings are parsed with both and results must be
+   identical. Then typical message fields are parsed in loop and average time
+   per field is printed. Program returns 1, if any result differs.
+
+ Example is for Linux or other PC. Build it on library directory with e.g.
+   g++ -std=gnu++11 -O2 -I. Examples/FieldParserBenchmark/main.cpp NMEA0183FieldParser.cpp -o FieldParserBenchmark
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "NMEA0183FieldParser.h"
+
+#define RandomTestCount 2000000
+#define BenchmarkCount 5000000
+
+// Own generator, so that strings are same on all platforms.
+static uint32_t RandomState=11;
+static uint32_t Random(uint32_t Max) {
+  RandomState=RandomState*1103515245+12345;
+  return (RandomState>>16)%Max;
+}
+
+//*****************************************************************************
+static double Now() {
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC,&t);
+  return t.tv_sec+t.tv_nsec*1e-9;
+}
+
+//*****************************************************************************
+// Make random number like "-123.4567". String may also be "-" or "." without digits.
+static void MakeRandomNumber(char *buf) {
+  int IntLen=Random(8);
+  int FracLen=Random(9);
+
+  if ( Random(5)==0 ) *buf++='-';
+  for ( int i=0; i<IntLen; i++ ) *buf++='0'+Random(10);
+  if ( FracLen>0 ) {
+    *buf++='.';
+    for ( int i=1; i<FracLen; i++ ) *buf++='0'+Random(10);
+  }
+  *buf=0;
+}
+
+//*****************************************************************************
+static int CheckRandomNumbers() {
+  char buf[32];
+  int Errors=0;
+
+  for ( int i=0; i<RandomTestCount; i++ ) {
+    MakeRandomNumber(buf);
+    double val;
+    bool Valid=NMEA0183FieldToDouble(buf,strlen(buf),val);
+    bool HasDigits=( strpbrk(buf,"0123456789")!=0 );
+    if ( Valid!=HasDigits || ( Valid && val!=atof(buf) ) ) {
+      if ( Errors<10 ) printf("Differs: %s %.17g atof %.17g\n",buf,val,atof(buf));
+      Errors++;
+    }
+  }
+  printf("Random numbers: %d of %d differ\n",Errors,RandomTestCount);
+
+  return Errors;
+}
+
+//*****************************************************************************
+// Compare with formulas used before field parser.
+static int CheckLatLonAndTime() {
+  const char *LatLons[]={"6035.04228","02115.15472","5246.241","00000.0000","8959.99999"};
+  const char *Times[]={"092348.00","235959.999","000000","123456.5"};
+  int Errors=0;
+
+  for ( size_t i=0; i<sizeof(LatLons)/sizeof(LatLons[0]); i++ ) {
+    double val, a=atof(LatLons[i]), deg=floor(a/100);
+    NMEA0183FieldToLatLon(LatLons[i],strlen(LatLons[i]),'N',val);
+    if ( fabs(val-(deg+(a-deg*100)/60))>1e-12 ) { printf("Differs: %s %.12f\n",LatLons[i],val); Errors++; }
+  }
+  for ( size_t i=0; i<sizeof(Times)/sizeof(Times[0]); i++ ) {
+    double val, a=atof(Times[i]), hh=floor(a/10000), mm=floor((a-hh*10000)/100);
+    NMEA0183FieldToSeconds(Times[i],strlen(Times[i]),val);
+    if ( fabs(val-(hh*3600+mm*60+(a-hh*10000-mm*100)))>1e-6 ) { printf("Differs: %s %.6f\n",Times[i],val); Errors++; }
+  }
+  printf("Lat/lon and time: %d differ\n",Errors);
+
+  return Errors;
+}
+
+//*****************************************************************************
+static void Benchmark() {
+  const char *Fields[]={"6035.04228","0.01","272.61","182435.00","4.0","20.6","244.71","12.5","0.9","10"};
+  const int FieldCount=sizeof(Fields)/sizeof(Fields[0]);
+  size_t Lens[FieldCount];
+  volatile double Sum=0; // Keeps compiler from dropping the loops
+
+  for ( int i=0; i<FieldCount; i++ ) Lens[i]=strlen(Fields[i]);
+
+  double t0=Now();
+  for ( int i=0; i<BenchmarkCount; i++ ) Sum+=atof(Fields[i%FieldCount]);
+  double t1=Now();
+  for ( int i=0; i<BenchmarkCount; i++ ) {
+    double val;
+    NMEA0183FieldToDouble(Fields[i%FieldCount],Lens[i%FieldCount],val);
+    Sum+=val;
+  }
+  double t2=Now();
+
+  printf("atof %.1f ns, NMEA0183FieldToDouble %.1f ns per field\n",
+         (t1-t0)*1e9/BenchmarkCount,(t2-t1)*1e9/BenchmarkCount);
+}
+
+//*****************************************************************************
+int main() {
+  int Errors=CheckRandomNumbers();
+  Errors+=CheckLatLonAndTime();
+  Benchmark();
+
+  return ( Errors==0 ? 0 : 1 );
+}
@@ -22,7 +22,7 @@ Author: Timo Lappalainen
 extern tNMEA0183 NMEA0183_Out;
 
 struct tNMEA0183Handler {
-  const char *Code;
+  uint32_t CodeId;
   void (*Handler)(const tNMEA0183Msg &NMEA0183Msg); 
 };
 
@@ -38,10 +38,10 @@ tBoatData *pBD=0;
 Stream* NMEA0183HandlersDebugStream=0;
 
 tNMEA0183Handler NMEA0183Handlers[]={
-  {"GGA",&HandleGGA},
-  {"HDT",&HandleHDT},
-  {"VTG",&HandleVTG},
-  {"RMC",&HandleRMC},
+  {NMEA0183MsgCodeGGA,&HandleGGA},
+  {NMEA0183MsgCodeHDT,&HandleHDT},
+  {NMEA0183MsgCodeVTG,&HandleVTG},
+  {NMEA0183MsgCodeRMC,&HandleRMC},
   {0,0}
 };
 
@@ -70,9 +70,9 @@ tN2kGNSSmethod GNSMethofNMEA0183ToN2k(int Method) {
 void HandleNMEA0183Msg(const tNMEA0183Msg &NMEA0183Msg) {
   int iHandler;
   // Find handler
-  for (iHandler=0; NMEA0183Handlers[iHandler].Code!=0 && !NMEA0183Msg.IsMessageCode(NMEA0183Handlers[iHandler].Code); iHandler++);
+  for (iHandler=0; NMEA0183Handlers[iHandler].CodeId!=0 && !NMEA0183Msg.IsMessageCodeId(NMEA0183Handlers[iHandler].CodeId); iHandler++);
   
-  if (NMEA0183Handlers[iHandler].Code!=0) {
+  if (NMEA0183Handlers[iHandler].CodeId!=0) {
     NMEA0183Handlers[iHandler].Handler(NMEA0183Msg); 
   }
   
@@ -19,33 +19,24 @@ Author: Timo Lappalainen
 #include <NMEA0183Messages.h>
 #include "NMEA0183Handlers.h"
 
-struct tNMEA0183Handler {
-  const char *Code;
-  void (*Handler)(const tNMEA0183Msg &NMEA0183Msg); 
-};
-
-// Predefinition for functions to make it possible for constant definition for NMEA0183Handlers
-void HandleRMC(const tNMEA0183Msg &NMEA0183Msg);
-void HandleGGA(const tNMEA0183Msg &NMEA0183Msg);
-void HandleHDT(const tNMEA0183Msg &NMEA0183Msg);
-void HandleVTG(const tNMEA0183Msg &NMEA0183Msg);
+// Predefinition for handler functions. Context is pointer to tBoatData.
+void HandleRMC(const tNMEA0183MsgView &NMEA0183Msg, void *Context);
+void HandleGGA(const tNMEA0183MsgView &NMEA0183Msg, void *Context);
+void HandleHDT(const tNMEA0183MsgView &NMEA0183Msg, void *Context);
+void HandleVTG(const tNMEA0183MsgView &NMEA0183Msg, void *Context);
 
 // Internal variables
 tNMEA2000 *pNMEA2000=0;
-tBoatData *pBD=0;
 Stream* NMEA0183HandlersDebugStream=0;
+tNMEA0183HandlerTableT<3> NMEA0183HandlerTable;
 
-tNMEA0183Handler NMEA0183Handlers[]={
-  {"GGA",&HandleGGA},
-  {"HDT",&HandleHDT},
-  {"VTG",&HandleVTG},
-  {"RMC",&HandleRMC},
-  {0,0}
-};
-
-void InitNMEA0183Handlers(tNMEA2000 *_NMEA2000, tBoatData *_BoatData) {
+void InitNMEA0183Handlers(tNMEA0183 &NMEA0183, tNMEA2000 *_NMEA2000, tBoatData *_BoatData) {
   pNMEA2000=_NMEA2000;
-  pBD=_BoatData;
+  NMEA0183.SetMsgHandlerTable(&NMEA0183HandlerTable);
+  NMEA0183.AddMsgHandlerId(NMEA0183MsgCodeGGA,HandleGGA,_BoatData);
+  NMEA0183.AddMsgHandlerId(NMEA0183MsgCodeHDT,HandleHDT,_BoatData);
+  NMEA0183.AddMsgHandlerId(NMEA0183MsgCodeVTG,HandleVTG,_BoatData);
+  NMEA0183.AddMsgHandlerId(NMEA0183MsgCodeRMC,HandleRMC,_BoatData);
 }
 
 void DebugNMEA0183Handlers(Stream* _stream) {
@@ -61,25 +52,18 @@ tN2kGNSSmethod GNSMethofNMEA0183ToN2k(int Method) {
   }
 }
 
-void HandleNMEA0183Msg(const tNMEA0183Msg &NMEA0183Msg) {
-  int iHandler;
-  // Find handler
-  for (iHandler=0; NMEA0183Handlers[iHandler].Code!=0 && !NMEA0183Msg.IsMessageCode(NMEA0183Handlers[iHandler].Code); iHandler++);
-  if (NMEA0183Handlers[iHandler].Code!=0) {
-    NMEA0183Handlers[iHandler].Handler(NMEA0183Msg); 
-  }
-}
-
 // NMEA0183 message Handler functions
 
-void HandleRMC(const tNMEA0183Msg &NMEA0183Msg) {
+void HandleRMC(const tNMEA0183MsgView &NMEA0183Msg, void *Context) {
+  tBoatData *pBD=(tBoatData *)Context;
   if (pBD==0) return;
   
   if (NMEA0183ParseRMC_nc(NMEA0183Msg,pBD->GPSTime,pBD->Latitude,pBD->Longitude,pBD->COG,pBD->SOG,pBD->DaysSince1970,pBD->Variation)) {
   } else if (NMEA0183HandlersDebugStream!=0) { NMEA0183HandlersDebugStream->println("Failed to parse RMC"); }
 }
 
-void HandleGGA(const tNMEA0183Msg &NMEA0183Msg) {
+void HandleGGA(const tNMEA0183MsgView &NMEA0183Msg, void *Context) {
+  tBoatData *pBD=(tBoatData *)Context;
   if (pBD==0) return;
   
   if (NMEA0183ParseGGA_nc(NMEA0183Msg,pBD->GPSTime,pBD->Latitude,pBD->Longitude,
@@ -111,7 +95,8 @@ void HandleGGA(const tNMEA0183Msg &NMEA0183Msg) {
 
 #define PI_2 6.283185307179586476925286766559
 
-void HandleHDT(const tNMEA0183Msg &NMEA0183Msg) {
+void HandleHDT(const tNMEA0183MsgView &NMEA0183Msg, void *Context) {
+  tBoatData *pBD=(tBoatData *)Context;
   if (pBD==0) return;
   
   if (NMEA0183ParseHDT_nc(NMEA0183Msg,pBD->TrueHeading)) {
@@ -131,7 +116,8 @@ void HandleHDT(const tNMEA0183Msg &NMEA0183Msg) {
   } else if (NMEA0183HandlersDebugStream!=0) { NMEA0183HandlersDebugStream->println("Failed to parse HDT"); }
 }
 
-void HandleVTG(const tNMEA0183Msg &NMEA0183Msg) {
+void HandleVTG(const tNMEA0183MsgView &NMEA0183Msg, void *Context) {
+  tBoatData *pBD=(tBoatData *)Context;
  double MagneticCOG;
   if (pBD==0) return;
   
@@ -22,11 +22,10 @@ Author: Timo Lappalainen
 #include <NMEA2000.h>
 #include "BoatData.h"
 
-void InitNMEA0183Handlers(tNMEA2000 *_NMEA2000, tBoatData *_BoatData);
+// Register message handlers to NMEA0183.
+void InitNMEA0183Handlers(tNMEA0183 &NMEA0183, tNMEA2000 *_NMEA2000, tBoatData *_BoatData);
 void DebugNMEA0183Handlers(Stream* _stream);
 
-void HandleNMEA0183Msg(const tNMEA0183Msg &NMEA0183Msg);
-
 #endif
 
 
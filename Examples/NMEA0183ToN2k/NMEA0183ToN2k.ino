@@ -6,11 +6,10 @@
  This example reads NMEA0183 messages from one serial port. It is possible
  to add more serial ports for having NMEA0183 combiner functionality.
 
- The messages, which will be handled has been defined on NMEA0183Handlers.cpp
- on NMEA0183Handlers variable initialization. So this does not automatically
- handle all NMEA0183 messages. If there is no handler for some message you need,
- you have to write handler for it and add it to the NMEA0183Handlers variable
- initialization. If you write new handlers, please after testing send them to me,
+ The messages, which will be handled has been registered on NMEA0183Handlers.cpp
+ on InitNMEA0183Handlers. So this does not automatically handle all NMEA0183
+ messages. If there is no handler for some message you need, you have to write
+ handler for it and register it on InitNMEA0183Handlers. If you write new handlers, please after testing send them to me,
  so I can add them for others use.
 */
 
@@ -60,8 +59,7 @@ void setup() {
   NMEA2000.Open();
 
   // Setup NMEA0183 ports and handlers
-  InitNMEA0183Handlers(&NMEA2000, &BoatData);
-  NMEA0183_3.SetMsgHandler(HandleNMEA0183Msg);
+  InitNMEA0183Handlers(NMEA0183_3, &NMEA2000, &BoatData);
 
   Serial3.begin(19200);
   NMEA0183_3.SetMessageStream(&Serial3);
@@ -22,17 +22,29 @@ OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 */
 
-#ifndef ARDUINO
-#include <cstdio>
-#endif
+#include <string.h>
 #include "NMEA0183.h"
+#include "NMEA0183Scan.h"
 
 //*****************************************************************************
 tNMEA0183::tNMEA0183(tNMEA0183Stream *stream, uint8_t _SourceID)
 : port(0), MsgCheckSumStartPos(SIZE_MAX),
-  MsgInPos(0), MsgInStarted(false),
+  MsgInBuf(DefaultMsgInBuf), MsgInBufSize(MAX_NMEA0183_MSG_BUF_LEN),
+  MsgInPos(0), MsgInLen(0), MsgInStarted(false), MsgInData(MsgInChunk), MsgInChunkPos(0), MsgInChunkLen(0),
   MsgOutWritePos(0), MsgOutReadPos(0), MsgOutBuf(0), MsgOutBufSize(3*MAX_NMEA0183_MSG_BUF_LEN),
-  MsgHandler(0)
+  MsgHandler(0), MsgViewHandler(0), MsgHandlers(0)
+{
+  SetMessageStream(stream,_SourceID);
+}
+
+//*****************************************************************************
+tNMEA0183::tNMEA0183(char *_MsgInBuf, size_t _MsgInBufSize, char *_MsgOutBuf, size_t _MsgOutBufSize,
+                     tNMEA0183Stream *stream, uint8_t _SourceID)
+: port(0), MsgCheckSumStartPos(SIZE_MAX),
+  MsgInBuf(_MsgInBuf!=0?_MsgInBuf:DefaultMsgInBuf), MsgInBufSize(_MsgInBufSize),
+  MsgInPos(0), MsgInLen(0), MsgInStarted(false), MsgInData(MsgInChunk), MsgInChunkPos(0), MsgInChunkLen(0),
+  MsgOutWritePos(0), MsgOutReadPos(0), MsgOutBuf(_MsgOutBuf), MsgOutBufSize(_MsgOutBufSize),
+  MsgHandler(0), MsgViewHandler(0), MsgHandlers(0)
 {
   SetMessageStream(stream,_SourceID);
 }
@@ -41,13 +53,16 @@ tNMEA0183::tNMEA0183(tNMEA0183Stream *stream, uint8_t _SourceID)
 void tNMEA0183::SetMessageStream(tNMEA0183Stream *stream, uint8_t _SourceID) {
   SourceID=_SourceID;
   port=stream;
+  // Span given by previous stream may not be valid anymore.
+  if ( MsgInData!=MsgInChunk ) { MsgInChunkPos=0; MsgInChunkLen=0; MsgInData=MsgInChunk; }
 }
 
 //*****************************************************************************
 bool tNMEA0183::Open() {
   if ( !IsOpen() ) {
     if ( MsgOutBuf==0 ) MsgOutBuf=new char[MsgOutBufSize];
-    MsgInPos=0; MsgInStarted=false;
+    ResetMsgIn();
+    MsgInChunkPos=0; MsgInChunkLen=0;
     MsgOutWritePos=0; MsgOutReadPos=0;
 
     return IsOpen();
@@ -75,125 +90,317 @@ void tNMEA0183::SetSendBufferSize(size_t size) {
 
 //*****************************************************************************
 void tNMEA0183::ParseMessages() {
-  tNMEA0183Msg NMEA0183Msg;
+    tNMEA0183MsgView NMEA0183MsgView;
+
+    if ( MsgHandler!=0 ) {
+      tNMEA0183Msg NMEA0183Msg;
+      ParseMessagesWith(&NMEA0183Msg,NMEA0183MsgView);
+    } else {
+      ParseMessagesWith(0,NMEA0183MsgView);
+    }
+}
 
+//*****************************************************************************
+void tNMEA0183::ParseMessagesWith(tNMEA0183Msg *NMEA0183Msg, tNMEA0183MsgView &NMEA0183MsgView) {
     if ( !Open() ) return;
 
-    while (GetMessage(NMEA0183Msg)) {
-      if (MsgHandler!=0) MsgHandler(NMEA0183Msg);
+    if ( NMEA0183Msg!=0 ) {
+      while (GetMessage(*NMEA0183Msg)) {
+        NMEA0183MsgView.SetMessage(*NMEA0183Msg);
+        DispatchMessage(*NMEA0183Msg,NMEA0183MsgView);
+      }
+    } else {
+      while (GetMessage(NMEA0183MsgView)) {
+        if (MsgViewHandler!=0) MsgViewHandler(NMEA0183MsgView);
+        if (MsgHandlers!=0) MsgHandlers->Dispatch(NMEA0183MsgView);
+      }
     }
     kick();
 }
 
 //*****************************************************************************
-bool tNMEA0183::GetMessage(tNMEA0183Msg &NMEA0183Msg) {
-  if ( !IsOpen() ) return false;
+// Message may be tNMEA0183MsgT with more fields than default view can hold. Larger
+// view is used only for such messages to save stack on small MCUs. Message data is
+// max 255 bytes and each field takes at least one, so 0xfe fields is always enough.
+void tNMEA0183::DispatchMessage(const tNMEA0183Msg &NMEA0183Msg) const {
+  if ( NMEA0183Msg.FieldCount()<=MAX_NMEA0183_MSG_FIELDS ) {
+    tNMEA0183MsgView NMEA0183MsgView(NMEA0183Msg);
+    DispatchMessage(NMEA0183Msg,NMEA0183MsgView);
+  } else {
+    tNMEA0183MsgViewT<0xfe> NMEA0183MsgView(NMEA0183Msg);
+    DispatchMessage(NMEA0183Msg,NMEA0183MsgView);
+  }
+}
 
-  bool result=false;
+//*****************************************************************************
+void tNMEA0183::DispatchMessage(const tNMEA0183Msg &NMEA0183Msg, const tNMEA0183MsgView &NMEA0183MsgView) const {
+  if (MsgHandler!=0) MsgHandler(NMEA0183Msg);
+  if (MsgViewHandler!=0) MsgViewHandler(NMEA0183MsgView);
+  if (MsgHandlers!=0) MsgHandlers->Dispatch(NMEA0183MsgView);
+}
 
-  while (port->available() > 0 && !result) {
-    int NewByte=port->read();
-      if (NewByte=='$' || NewByte=='!') { // Message start
-        MsgInStarted=true;
-        MsgInPos=0;
-        MsgInBuf[MsgInPos]=NewByte;
-        MsgInPos++;
-      } else if (MsgInStarted) {
-        MsgInBuf[MsgInPos]=NewByte;
-        if (NewByte=='*') MsgCheckSumStartPos=MsgInPos;
+//*****************************************************************************
+// Wildcard is 0, "" or "*". Otherwise id must be packable.
+static bool MsgHandlerIds(const char *Code, const char *Sender, uint32_t &CodeId, uint16_t &SenderId) {
+  CodeId=0; SenderId=0;
+  if ( Code!=0 && Code[0]!=0 && strcmp(Code,"*")!=0 ) {
+    if ( (CodeId=NMEA0183MsgCodeId(Code))==0 ) return false;
+  }
+  if ( Sender!=0 && Sender[0]!=0 && strcmp(Sender,"*")!=0 ) {
+    if ( (SenderId=NMEA0183SenderId(Sender))==0 || Sender[2]!=0 ) return false;
+  }
+
+  return true;
+}
+
+//*****************************************************************************
+bool tNMEA0183::AddMsgHandler(const char *Code, tNMEA0183MsgHandlerFunc Handler, void *Context, const char *Sender) {
+  uint32_t CodeId;
+  uint16_t SenderId;
+
+  if ( MsgHandlers==0 || !MsgHandlerIds(Code,Sender,CodeId,SenderId) ) return false;
+  return MsgHandlers->Add(SenderId,CodeId,Handler,Context);
+}
+
+//*****************************************************************************
+bool tNMEA0183::RemoveMsgHandler(const char *Code, const char *Sender) {
+  uint32_t CodeId;
+  uint16_t SenderId;
+
+  if ( MsgHandlers==0 || !MsgHandlerIds(Code,Sender,CodeId,SenderId) ) return false;
+  return MsgHandlers->Remove(SenderId,CodeId);
+}
+
+//*****************************************************************************
+size_t tNMEA0183::FrameBytes(const char *buf, size_t len, bool &Complete) {
+  const char *p=buf;
+  const char *end=buf+len;
+
+  Complete=false;
+
+  while ( p<end && !Complete ) {
+    if ( !MsgInStarted ) {
+      p=NMEA0183FindFirst(p,end,NMEA0183Scan_Start);
+      if ( p==0 ) return len; // No message start on rest of buffer
+      MsgInStarted=true;
+      MsgInBuf[0]=*p;
+      MsgInPos=1;
+      MsgCheckSumStartPos=SIZE_MAX;
+      p++;
+    } else if ( MsgCheckSumStartPos!=SIZE_MAX ) { // Receiving checksum characters
+      if ( *p=='$' || *p=='!' ) { // New message start before full checksum
+        ResetMsgIn();
+        continue;
+      }
+      MsgInBuf[MsgInPos]=*p;
+      MsgInPos++;
+      p++;
+      if ( MsgInPos>=MsgInBufSize ) { // Too may chars in message. Start from beginning
+        ResetMsgIn();
+      } else if ( MsgCheckSumStartPos+3==MsgInPos ) { // We have full checksum and so full message
+        MsgInBuf[MsgInPos]=0; // add null termination
+        MsgInLen=MsgInPos;
+        Complete=true;
+        ResetMsgIn();
+      }
+    } else { // Copy message data until next delimiter at once
+      const char *Delimiter=NMEA0183FindFirst(p,end,NMEA0183Scan_Start | NMEA0183Scan_CheckSum | NMEA0183Scan_LineEnd);
+      size_t n=(Delimiter!=0?Delimiter:end)-p;
+
+      if ( MsgInPos+n>=MsgInBufSize ) { // Too may chars in message. Start from beginning
+        ResetMsgIn();
+        p+=n;
+        continue;
+      }
+      memcpy(MsgInBuf+MsgInPos,p,n);
+      MsgInPos+=n;
+      p+=n;
+      if ( Delimiter==0 ) continue;
+      if ( *Delimiter=='*' ) {
+        MsgCheckSumStartPos=MsgInPos;
+        MsgInBuf[MsgInPos]='*';
         MsgInPos++;
-        if (MsgCheckSumStartPos!=SIZE_MAX and MsgCheckSumStartPos+3==MsgInPos) { // We have full checksum and so full message
-            MsgInBuf[MsgInPos]=0; // add null termination
-          if (NMEA0183Msg.SetMessage(MsgInBuf)) {
-            NMEA0183Msg.SourceID=SourceID;
-            result=true;
-          }
-          MsgInStarted=false;
-          MsgInPos=0;
-          MsgCheckSumStartPos=SIZE_MAX;
-        }
-        if (MsgInPos>=MAX_NMEA0183_MSG_BUF_LEN) { // Too may chars in message. Start from beginning
-          MsgInStarted=false;
-          MsgInPos=0;
-          MsgCheckSumStartPos=SIZE_MAX;
-        }
+        p++;
+        if ( MsgInPos>=MsgInBufSize ) ResetMsgIn();
+      } else { // New message start or line end before checksum
+        ResetMsgIn();
       }
+    }
+  }
+
+  return p-buf;
+}
+
+//*****************************************************************************
+// Read available bytes from stream. Streams, which can not read in bulk, will
+// fall back to byte by byte reading. Streams having data in memory give it
+// directly without copying.
+size_t tNMEA0183::ReadChunk() {
+  MsgInData=MsgInChunk;
+  #ifdef ARDUINO
+  int Available=port->available();
+  if ( Available<=0 ) return 0;
+  size_t len=( (size_t)Available<NMEA0183_IN_CHUNK_LEN ? Available : NMEA0183_IN_CHUNK_LEN );
+  return port->readBytes(MsgInChunk,len);
+  #else
+  const uint8_t *Span;
+  size_t len=port->readSpan(Span,SIZE_MAX);
+  if ( Span!=0 ) {
+    MsgInData=(const char *)Span;
+    return len;
+  }
+  return port->read((uint8_t *)MsgInChunk,NMEA0183_IN_CHUNK_LEN);
+  #endif
+}
+
+//*****************************************************************************
+bool tNMEA0183::FrameMessage() {
+  bool Complete=false;
+
+  while ( !Complete ) {
+    if ( MsgInChunkPos>=MsgInChunkLen ) {
+      MsgInChunkPos=0;
+      MsgInChunkLen=ReadChunk();
+      if ( MsgInChunkLen==0 ) break;
+    }
+    MsgInChunkPos+=FrameBytes(MsgInData+MsgInChunkPos,MsgInChunkLen-MsgInChunkPos,Complete);
+  }
+
+  return Complete;
+}
+
+//*****************************************************************************
+bool tNMEA0183::GetMessage(tNMEA0183Msg &NMEA0183Msg) {
+  if ( !IsOpen() ) return false;
+
+  while ( FrameMessage() ) {
+    if ( NMEA0183Msg.SetMessage(MsgInBuf,MsgInLen) ) {
+      NMEA0183Msg.SourceID=SourceID;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+//*****************************************************************************
+bool tNMEA0183::GetMessage(tNMEA0183MsgView &NMEA0183Msg) {
+  if ( !IsOpen() ) return false;
+
+  while ( FrameMessage() ) {
+    if ( NMEA0183Msg.SetMessage(MsgInBuf,MsgInLen) ) {
+      NMEA0183Msg.SourceID=SourceID;
+      return true;
+    }
   }
 
-  return result;
+  return false;
 }
 
 //*****************************************************************************
+// Reserve room for whole sentence, write it to send ring and commit it by moving
+// write position. So sentence will be sent whole or not at all.
 bool tNMEA0183::SendMessage(const tNMEA0183Msg &NMEA0183Msg) {
   if ( !Open() ) return false;
 
-  char buf[7]={NMEA0183Msg.GetPrefix(),0};
+  uint8_t FieldCount=NMEA0183Msg.FieldCount();
+  size_t SenderLen=strlen(NMEA0183Msg.Sender());
+  size_t CodeLen=strlen(NMEA0183Msg.MessageCode());
+  size_t len=1+SenderLen+CodeLen+5; // prefix, sender, code and *hh\r\n
 
-  SendBuf(buf);
-  SendBuf(NMEA0183Msg.Sender());
-  SendBuf(NMEA0183Msg.MessageCode());
-  for (int i=0; i<NMEA0183Msg.FieldCount(); i++) {
-    SendBuf(",");
-    SendBuf(NMEA0183Msg.Field(i));
+  for ( uint8_t i=0; i<FieldCount; i++ ) {
+    len+=1+NMEA0183Msg.FieldLen(i);
   }
-  sprintf(buf,"*%02X\r\n",NMEA0183Msg.GetCheckSum());
-  return SendBuf(buf);
+
+  kick();
+  if ( len>=MsgOutBufFreeSize() ) return false;
+
+  char buf[6]={NMEA0183Msg.GetPrefix(),0};
+  size_t Pos=PutOut(MsgOutWritePos,buf,1);
+  Pos=PutOut(Pos,NMEA0183Msg.Sender(),SenderLen);
+  Pos=PutOut(Pos,NMEA0183Msg.MessageCode(),CodeLen);
+  for ( uint8_t i=0; i<FieldCount; i++ ) {
+    Pos=PutOut(Pos,",",1);
+    Pos=PutOut(Pos,NMEA0183Msg.Field(i),NMEA0183Msg.FieldLen(i));
+  }
+  strcpy(buf,"*hh\r\n");
+  NMEA0183FormatHexByte(buf+1,NMEA0183Msg.GetCheckSum());
+  MsgOutWritePos=PutOut(Pos,buf,5);
+
+  kick();
+
+  return true;
 }
 
 //*****************************************************************************
-// availableForWrite does not exists on all implementations.
-bool tNMEA0183::CanSendByte() {
+// availableForWrite does not exists on all implementations, so on those port
+// will be just offered all data.
+size_t tNMEA0183::WritableBytes() {
   #if defined(ARDUINO_ARCH_ESP32)
-  return true;
+  return SIZE_MAX;
   #else
-  return port->availableForWrite() > 0;
+  int Available=port->availableForWrite();
+  return ( Available>0 ? (size_t)Available : 0 );
   #endif
 }
 
+//*****************************************************************************
+size_t tNMEA0183::WriteBurst(const char *buf, size_t len) {
+  size_t Writable=WritableBytes();
+
+  if ( len>Writable ) len=Writable;
+  if ( len==0 ) return 0;
+
+  return port->write((const uint8_t *)buf,len);
+}
+
 //*****************************************************************************
 void tNMEA0183::kick() {
   if ( !Open() ) return;
 
-  while ( MsgOutWritePos!=MsgOutReadPos && CanSendByte() ) {
-    port->write(MsgOutBuf[MsgOutReadPos]);
-    MsgOutReadPos=(MsgOutReadPos + 1) % MsgOutBufSize;
+  while ( MsgOutWritePos!=MsgOutReadPos ) {
+    // Send contiguous data until write position or end of ring.
+    size_t len=( MsgOutReadPos<MsgOutWritePos ? MsgOutWritePos : MsgOutBufSize )-MsgOutReadPos;
+    size_t Written=WriteBurst(MsgOutBuf+MsgOutReadPos,len);
+    if ( Written>len ) Written=len;
+    MsgOutReadPos+=Written;
+    if ( MsgOutReadPos>=MsgOutBufSize ) MsgOutReadPos=0;
+    if ( Written<len ) break; // Port is full
   }
+  // Start from beginning when ring is empty, so that next message is contiguous.
+  if ( MsgOutReadPos==MsgOutWritePos ) { MsgOutReadPos=0; MsgOutWritePos=0; }
 }
 
 //*****************************************************************************
-bool tNMEA0183::SendBuf(const char *buf) {
-  kick();
+size_t tNMEA0183::PutOut(size_t Pos, const char *buf, size_t len) {
+  size_t len1=MsgOutBufSize-Pos;
 
-  if ( buf==0 ) return true;
+  if ( len1>len ) len1=len;
+  memcpy(MsgOutBuf+Pos,buf,len1);
+  memcpy(MsgOutBuf,buf+len1,len-len1);
+  Pos+=len;
+  if ( Pos>=MsgOutBufSize ) Pos-=MsgOutBufSize;
 
-  size_t iBuf=0;
-
-  if ( MsgOutWritePos==MsgOutReadPos ) { // try to send immediately
-    for (; CanSendByte() > 0 && buf[iBuf]!=0; iBuf++ ) {
-      port->write(buf[iBuf]);
-    }
-  }
+  return Pos;
+}
 
-  if ( buf[iBuf]==0 ) {
-    return true;
-  }
+//*****************************************************************************
+bool tNMEA0183::SendBuf(const char *buf, size_t len) {
+  kick();
 
-  // Could not send immediately, so buffer message
-  if ( strlen(buf)-iBuf >= MsgOutBufFreeSize() ) return false; // No room for message
+  if ( buf==0 || len==0 ) return true;
 
-  size_t wp=MsgOutWritePos;
+  // Check room before writing anything, so that message will not be sent partially,
+  // if port accepts less than it promised.
+  if ( len>=MsgOutBufFreeSize() ) return false;
 
-  for (size_t temp = (MsgOutWritePos + 1) % MsgOutBufSize;
-       buf[iBuf]!=0 && temp!=MsgOutReadPos;
-       temp = (MsgOutWritePos + 1) % MsgOutBufSize ) {
-    MsgOutBuf[MsgOutWritePos]=buf[iBuf];
-    MsgOutWritePos=temp;
+  size_t Written=0;
+  if ( MsgOutWritePos==MsgOutReadPos ) { // Nothing buffered, so we can try to send immediately
+    Written=WriteBurst(buf,len);
+    if ( Written>len ) Written=len;
   }
 
-  if ( buf[iBuf]!=0 ) {
-    MsgOutWritePos=wp;  // Cancel sending
-    return false;
-  }
+  if ( Written<len ) MsgOutWritePos=PutOut(MsgOutWritePos,buf+Written,len-Written);
 
   return true;
 }
@@ -26,19 +26,38 @@ OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #define _tNMEA0183_H_
 
 #include <stdint.h>
+#include <string.h>
 #include "NMEA0183Stream.h"
 #include "NMEA0183Msg.h"
+#include "NMEA0183MsgView.h"
+#include "NMEA0183HandlerTable.h"
 
 #define MAX_NMEA0183_MSG_BUF_LEN 81  // According to NMEA 3.01. Can not contain multi message as in AIS
 
+// Size of the chunk, which will be read from stream at once.
+#ifndef NMEA0183_IN_CHUNK_LEN
+#if defined(__AVR__)
+#define NMEA0183_IN_CHUNK_LEN 16
+#else
+#define NMEA0183_IN_CHUNK_LEN 256
+#endif
+#endif
+
 class tNMEA0183
 {
   protected:
     tNMEA0183Stream *port;
     size_t MsgCheckSumStartPos;
-    char MsgInBuf[MAX_NMEA0183_MSG_BUF_LEN];
+    char *MsgInBuf;
+    size_t MsgInBufSize;
     size_t MsgInPos;
+    size_t MsgInLen;  // Length of last framed message on MsgInBuf
     bool MsgInStarted;
+    char MsgInChunk[NMEA0183_IN_CHUNK_LEN]; // Bytes read from stream, but not yet framed
+    char DefaultMsgInBuf[MAX_NMEA0183_MSG_BUF_LEN]; // MsgInBuf, if tNMEA0183T does not give larger one
+    const char *MsgInData; // MsgInChunk or span given by stream
+    size_t MsgInChunkPos;
+    size_t MsgInChunkLen;
     size_t MsgOutWritePos;
     size_t MsgOutReadPos;
     char *MsgOutBuf;
@@ -47,14 +66,41 @@ class tNMEA0183
 
     // Handler callback
     void (*MsgHandler)(const tNMEA0183Msg &NMEA0183Msg);
+    void (*MsgViewHandler)(const tNMEA0183MsgView &NMEA0183Msg);
+    tNMEA0183HandlerTable *MsgHandlers; // Given by user, so ports without handlers do not pay for table
 
     size_t MsgOutBufFreeSize() {
-      return (MsgOutReadPos<MsgOutWritePos?MsgOutBufSize-(MsgOutWritePos-MsgOutReadPos):MsgOutBufSize+MsgOutReadPos-MsgOutWritePos);
+      return (MsgOutReadPos<=MsgOutWritePos?MsgOutBufSize-(MsgOutWritePos-MsgOutReadPos):MsgOutReadPos-MsgOutWritePos);
     }
-    bool IsOpen() const { return ( port!=0 && MsgOutBuf!=0 ); }
-    bool SendBuf(const char *buf);
-    bool CanSendByte();
+    bool IsOpen() const { return ( port!=0 && MsgInBuf!=0 && MsgOutBuf!=0 ); }
+    void ResetMsgIn() { MsgInStarted=false; MsgInPos=0; MsgCheckSumStartPos=SIZE_MAX; }
+    // Frame bytes from buf to MsgInBuf. Returns count of bytes consumed. Complete is set, when
+    // MsgInBuf contains full null terminated message.
+    size_t FrameBytes(const char *buf, size_t len, bool &Complete);
+    // Read stream until there is full message on MsgInBuf or no more data available.
+    bool FrameMessage();
+    // Read available bytes from stream and set MsgInData to point them. Returns count of bytes.
+    size_t ReadChunk();
+    // Count of bytes, which can be written to port without blocking.
+    size_t WritableBytes();
+    // Write as much of buf as port accepts without blocking. Returns count of written bytes.
+    size_t WriteBurst(const char *buf, size_t len);
+    // Copy len bytes to send ring from Pos in max two segments. Returns position after data.
+    // Data will be sent after MsgOutWritePos has been set to returned position. Caller must
+    // check free space.
+    size_t PutOut(size_t Pos, const char *buf, size_t len);
+    bool SendBuf(const char *buf, size_t len);
+    bool SendBuf(const char *buf) { return SendBuf(buf,(buf!=0?strlen(buf):0)); }
+    // Read and dispatch messages with given message and view. Message 0 means that only
+    // views will be dispatched.
+    void ParseMessagesWith(tNMEA0183Msg *NMEA0183Msg, tNMEA0183MsgView &NMEA0183MsgView);
+    // Call handlers with message and view already set to it.
+    void DispatchMessage(const tNMEA0183Msg &NMEA0183Msg, const tNMEA0183MsgView &NMEA0183MsgView) const;
+    // Use buffers given by tNMEA0183T. If _MsgInBuf is 0, DefaultMsgInBuf will be used.
+    tNMEA0183(char *_MsgInBuf, size_t _MsgInBufSize, char *_MsgOutBuf, size_t _MsgOutBufSize,
+              tNMEA0183Stream *stream, uint8_t _SourceID);
   public:
+    // Send buffer will be allocated on Open(). Use tNMEA0183T to avoid heap.
     tNMEA0183(tNMEA0183Stream *stream=0, uint8_t _SourceID=0);
     void SetMessageStream(tNMEA0183Stream *stream, uint8_t _SourceID=0);
     bool Open();
@@ -62,23 +108,92 @@ class tNMEA0183
     // Begin is obsolete. Use Open(...)
     void Begin(HardwareSerial *_port, uint8_t _SourceID=0, unsigned long _baud=4800);
     #endif
-    // Set size for send message buffer. Call this before Open().
+    // Set size for send message buffer. Call this before Open(). Has no effect for tNMEA0183T.
     void SetSendBufferSize(size_t size);
     // Set call back function, which will be called for new messages on ParseMessages.
     void SetMsgHandler(void (*_MsgHandler)(const tNMEA0183Msg &NMEA0183Msg)) {MsgHandler=_MsgHandler;}
+    // Set call back function, which will get view to received message. If only view handler has been set,
+    // messages will not be copied on ParseMessages.
+    void SetMsgViewHandler(void (*_MsgViewHandler)(const tNMEA0183MsgView &NMEA0183Msg)) {MsgViewHandler=_MsgViewHandler;}
+    // Set table for handlers below. Table must exist as long as port uses it. Several ports can
+    // share same table. E.g.
+    //   tNMEA0183HandlerTableT<> Handlers;
+    //   NMEA0183.SetMsgHandlerTable(&Handlers);
+    void SetMsgHandlerTable(tNMEA0183HandlerTable *_MsgHandlers) { MsgHandlers=_MsgHandlers; }
+    // Add handler for message code like "RMC" and optionally for sender like "GP". Code or sender 0, "" or "*"
+    // means any. Context will be given to handler. Handlers will be called on ParseMessages after handlers above.
+    // Returns false, if there is no handler table, table is full or code or sender can not be packed to id.
+    bool AddMsgHandler(const char *Code, tNMEA0183MsgHandlerFunc Handler, void *Context=0, const char *Sender=0);
+    // Add handler by ids like NMEA0183MsgCodeRMC. Id 0 means any.
+    bool AddMsgHandlerId(uint32_t CodeId, tNMEA0183MsgHandlerFunc Handler, void *Context=0, uint16_t SenderId=0) {
+      return ( MsgHandlers!=0 && MsgHandlers->Add(SenderId,CodeId,Handler,Context) );
+    }
+    bool RemoveMsgHandler(const char *Code, const char *Sender=0);
     // Call this in loop to read incoming messages or empty buffered sent messages.
     // For new messages message handler will be called.
-    void ParseMessages();
+    virtual void ParseMessages();
     // You can also read incoming messages with GetMessage. Function
     // returns true, when there is valid message.
     bool GetMessage(tNMEA0183Msg &NMEA0183Msg);
+    // Read incoming message without copying it. View is valid until next
+    // call of GetMessage or ParseMessages.
+    bool GetMessage(tNMEA0183MsgView &NMEA0183Msg);
+    // Call all handlers set for message. ParseMessages uses this for received messages.
+    // Handlers must not be changed, while messages are dispatched from other thread.
+    virtual void DispatchMessage(const tNMEA0183Msg &NMEA0183Msg) const;
     // Function will send message immediately of buffer it. Call ParseMessages()
     // in loop so that buffered messages will be sent.
     bool SendMessage(const tNMEA0183Msg &NMEA0183Msg);
 
+    // Returns true, if there is buffered data waiting to be sent. Call kick() or
+    // ParseMessages() to send it, when port is writable.
+    bool HasPendingOut() const { return MsgOutWritePos!=MsgOutReadPos; }
+
     // These are obsolete. Use SendMessage
     bool SendMessage(const char *buf);
     void kick();
 };
 
+//------------------------------------------------------------------------------
+// Port with compile time buffer sizes and message capacity. Buffers are inside
+// the object, so port never uses heap. RxLen is max received message length
+// including null termination, TxLen size of send buffer and MaxFields max field
+// count of received messages. E.g. small MCU could use tNMEA0183T<40,128,10>
+// for GPS, which sends only short sentences, and gateway tNMEA0183T<200,1024,40>
+// for long proprietary sentences.
+template <size_t RxLen, size_t TxLen, uint8_t MaxFields=MAX_NMEA0183_MSG_FIELDS>
+class tNMEA0183T : public tNMEA0183
+{
+  // Field positions on messages are uint8_t.
+  static_assert(RxLen>=16 && RxLen<=256 && TxLen>=RxLen,"Invalid buffer size");
+
+  protected:
+    static const uint8_t MsgLen=( RxLen>0xff ? 0xff : RxLen );
+    // Own receive buffer is needed only, if default one is not large enough.
+    char RxBuf[RxLen>MAX_NMEA0183_MSG_BUF_LEN?RxLen:1];
+    char TxBuf[TxLen];
+
+  public:
+    tNMEA0183T(tNMEA0183Stream *stream=0, uint8_t _SourceID=0)
+      : tNMEA0183(RxLen>MAX_NMEA0183_MSG_BUF_LEN?RxBuf:0,RxLen,TxBuf,TxLen,stream,_SourceID) {}
+
+    virtual void ParseMessages() {
+      tNMEA0183MsgViewT<MaxFields> NMEA0183MsgView;
+
+      if ( MsgHandler!=0 ) {
+        tNMEA0183MsgT<MsgLen,MaxFields> NMEA0183Msg;
+        ParseMessagesWith(&NMEA0183Msg,NMEA0183MsgView);
+      } else {
+        ParseMessagesWith(0,NMEA0183MsgView);
+      }
+    }
+
+    virtual void DispatchMessage(const tNMEA0183Msg &NMEA0183Msg) const {
+      if ( NMEA0183Msg.FieldCount()>MaxFields ) { tNMEA0183::DispatchMessage(NMEA0183Msg); return; }
+
+      tNMEA0183MsgViewT<MaxFields> NMEA0183MsgView(NMEA0183Msg);
+      tNMEA0183::DispatchMessage(NMEA0183Msg,NMEA0183MsgView);
+    }
+};
+
 #endif
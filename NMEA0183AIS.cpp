@@ -0,0 +1,279 @@
+/*
+NMEA0183AIS.cpp
+
+Copyright (c) 2015-2019 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#include <string.h>
+#include "NMEA0183AIS.h"
+
+const uint8_t NMEA0183AISArmorTable[128]={
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+  0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f,
+  0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0x28, 0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37,
+  0x38, 0x39, 0x3a, 0x3b, 0x3c, 0x3d, 0x3e, 0x3f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff
+};
+
+//*****************************************************************************
+static inline uint8_t ArmorValue(char c, uint8_t &Invalid) {
+  uint8_t v=NMEA0183AISArmorTable[(uint8_t)c & 0x7f];
+  Invalid|=( (uint8_t)c>=128 ? 0xff : v );
+  return v;
+}
+
+//*****************************************************************************
+// Four characters give three bytes, so main loop needs no bit position bookkeeping.
+// Invalid characters are collected to one flag and checked once.
+bool NMEA0183AISDeArmor(const char *Payload, uint16_t Len, uint8_t FillBits, tNMEA0183AISBits &Bits) {
+  uint8_t *d=Bits.Data;
+  uint8_t Invalid=0;
+  uint16_t i=0;
+
+  if ( Payload==0 || Len>NMEA0183_AIS_MAX_PAYLOAD_LEN || FillBits>5 ) return false;
+
+  for ( ; i+4<=Len; i+=4, d+=3 ) {
+    uint32_t v=((uint32_t)ArmorValue(Payload[i],Invalid)<<18) | ((uint32_t)ArmorValue(Payload[i+1],Invalid)<<12) |
+               ((uint32_t)ArmorValue(Payload[i+2],Invalid)<<6) | ArmorValue(Payload[i+3],Invalid);
+    d[0]=v>>16; d[1]=v>>8; d[2]=v;
+  }
+  uint32_t v=0;
+  uint8_t Rest=Len-i;
+  for ( ; i<Len; i++ ) v=(v<<6) | ArmorValue(Payload[i],Invalid);
+  v<<=6*(4-Rest);
+  d[0]=v>>16; d[1]=v>>8; d[2]=v;
+  if ( (Invalid & 0xc0)!=0 ) return false;
+
+  size_t Used=d+3-Bits.Data;
+  memset(Bits.Data+Used,0,sizeof(Bits.Data)-Used);
+  Bits.BitLen=Len*6-( FillBits<Len*6 ? FillBits : 0 );
+
+  return true;
+}
+
+//*****************************************************************************
+uint32_t tNMEA0183AISBits::Get(uint16_t Start, uint8_t Width) const {
+  if ( Width<1 || Width>32 || Start+Width>NMEA0183_AIS_MAX_BITS ) return 0;
+
+  uint8_t Bytes=(Start%8+Width+7)/8;
+  const uint8_t *p=Data+Start/8;
+  uint64_t v=0;
+  for ( uint8_t i=0; i<Bytes; i++ ) v=(v<<8) | p[i];
+
+  return (uint32_t)(v>>(Bytes*8-Start%8-Width)) & (uint32_t)(0xffffffffUL>>(32-Width));
+}
+
+//*****************************************************************************
+// 6 bit values 0-31 are '@'-'_' and 32-63 are ' '-'?'. '@' is used as padding.
+void tNMEA0183AISBits::GetText(uint16_t Start, uint8_t Chars, char *Text) const {
+  uint8_t i=0;
+
+  for ( ; i<Chars; i++ ) {
+    uint8_t v=Get(Start+i*6,6);
+    Text[i]=( v<32 ? v+64 : v );
+  }
+  for ( ; i>0 && (Text[i-1]=='@' || Text[i-1]==' '); i-- );
+  Text[i]=0;
+}
+
+//*****************************************************************************
+bool NMEA0183AISDecodePositionReport(const tNMEA0183AISBits &Bits, tAISPositionReport &Report) {
+  Report.MessageType=Bits.Get<0,6>();
+  if ( Report.MessageType<1 || Report.MessageType>3 || Bits.BitLen<168 ) return false;
+
+  Report.Repeat=Bits.Get<6,2>();
+  Report.MMSI=Bits.Get<8,30>();
+  Report.NavStatus=Bits.Get<38,4>();
+  Report.ROT=Bits.GetSigned<42,8>();
+  Report.SOG=Bits.Get<50,10>();
+  Report.Accuracy=Bits.Get<60,1>();
+  Report.Longitude=Bits.GetSigned<61,28>();
+  Report.Latitude=Bits.GetSigned<89,27>();
+  Report.COG=Bits.Get<116,12>();
+  Report.Heading=Bits.Get<128,9>();
+  Report.Second=Bits.Get<137,6>();
+  Report.Maneuver=Bits.Get<143,2>();
+  Report.RAIM=Bits.Get<148,1>();
+  Report.Radio=Bits.Get<149,19>();
+
+  return true;
+}
+
+//*****************************************************************************
+// Many transmitters send type 5 with 420 bits, so last bits will be read as 0.
+bool NMEA0183AISDecodeStaticVoyage(const tNMEA0183AISBits &Bits, tAISStaticVoyage &Voyage) {
+  if ( Bits.Get<0,6>()!=5 || Bits.BitLen<420 ) return false;
+
+  Voyage.Repeat=Bits.Get<6,2>();
+  Voyage.MMSI=Bits.Get<8,30>();
+  Voyage.AISVersion=Bits.Get<38,2>();
+  Voyage.IMO=Bits.Get<40,30>();
+  Bits.GetText(70,7,Voyage.CallSign);
+  Bits.GetText(112,20,Voyage.Name);
+  Voyage.ShipType=Bits.Get<232,8>();
+  Voyage.ToBow=Bits.Get<240,9>();
+  Voyage.ToStern=Bits.Get<249,9>();
+  Voyage.ToPort=Bits.Get<258,6>();
+  Voyage.ToStarboard=Bits.Get<264,6>();
+  Voyage.EPFD=Bits.Get<270,4>();
+  Voyage.ETAMonth=Bits.Get<274,4>();
+  Voyage.ETADay=Bits.Get<278,5>();
+  Voyage.ETAHour=Bits.Get<283,5>();
+  Voyage.ETAMinute=Bits.Get<288,6>();
+  Voyage.Draught=Bits.Get<294,8>();
+  Bits.GetText(302,20,Voyage.Destination);
+  Voyage.DTE=Bits.Get<422,1>();
+
+  return true;
+}
+
+//*****************************************************************************
+bool NMEA0183AISDecodeClassBPosition(const tNMEA0183AISBits &Bits, tAISClassBPosition &Report) {
+  if ( Bits.Get<0,6>()!=18 || Bits.BitLen<168 ) return false;
+
+  Report.Repeat=Bits.Get<6,2>();
+  Report.MMSI=Bits.Get<8,30>();
+  Report.SOG=Bits.Get<46,10>();
+  Report.Accuracy=Bits.Get<56,1>();
+  Report.Longitude=Bits.GetSigned<57,28>();
+  Report.Latitude=Bits.GetSigned<85,27>();
+  Report.COG=Bits.Get<112,12>();
+  Report.Heading=Bits.Get<124,9>();
+  Report.Second=Bits.Get<133,6>();
+  Report.CSUnit=Bits.Get<141,1>();
+  Report.Display=Bits.Get<142,1>();
+  Report.DSC=Bits.Get<143,1>();
+  Report.Band=Bits.Get<144,1>();
+  Report.Msg22=Bits.Get<145,1>();
+  Report.Assigned=Bits.Get<146,1>();
+  Report.RAIM=Bits.Get<147,1>();
+  Report.Radio=Bits.Get<148,20>();
+
+  return true;
+}
+
+//*****************************************************************************
+bool NMEA0183AISDecodeExtendedClassB(const tNMEA0183AISBits &Bits, tAISExtendedClassB &Report) {
+  if ( Bits.Get<0,6>()!=19 || Bits.BitLen<312 ) return false;
+
+  Report.Repeat=Bits.Get<6,2>();
+  Report.MMSI=Bits.Get<8,30>();
+  Report.SOG=Bits.Get<46,10>();
+  Report.Accuracy=Bits.Get<56,1>();
+  Report.Longitude=Bits.GetSigned<57,28>();
+  Report.Latitude=Bits.GetSigned<85,27>();
+  Report.COG=Bits.Get<112,12>();
+  Report.Heading=Bits.Get<124,9>();
+  Report.Second=Bits.Get<133,6>();
+  Bits.GetText(143,20,Report.Name);
+  Report.ShipType=Bits.Get<263,8>();
+  Report.ToBow=Bits.Get<271,9>();
+  Report.ToStern=Bits.Get<280,9>();
+  Report.ToPort=Bits.Get<289,6>();
+  Report.ToStarboard=Bits.Get<295,6>();
+  Report.EPFD=Bits.Get<301,4>();
+  Report.RAIM=Bits.Get<305,1>();
+  Report.DTE=Bits.Get<306,1>();
+  Report.Assigned=Bits.Get<307,1>();
+
+  return true;
+}
+
+//*****************************************************************************
+// Name extension has 0-14 characters after bit 272.
+bool NMEA0183AISDecodeAidToNavigation(const tNMEA0183AISBits &Bits, tAISAidToNavigation &Aid) {
+  if ( Bits.Get<0,6>()!=21 || Bits.BitLen<272 ) return false;
+
+  Aid.Repeat=Bits.Get<6,2>();
+  Aid.MMSI=Bits.Get<8,30>();
+  Aid.AidType=Bits.Get<38,5>();
+  Bits.GetText(43,20,Aid.Name);
+  Aid.Accuracy=Bits.Get<163,1>();
+  Aid.Longitude=Bits.GetSigned<164,28>();
+  Aid.Latitude=Bits.GetSigned<192,27>();
+  Aid.ToBow=Bits.Get<219,9>();
+  Aid.ToStern=Bits.Get<228,9>();
+  Aid.ToPort=Bits.Get<237,6>();
+  Aid.ToStarboard=Bits.Get<243,6>();
+  Aid.EPFD=Bits.Get<249,4>();
+  Aid.Second=Bits.Get<253,6>();
+  Aid.OffPosition=Bits.Get<259,1>();
+  Aid.RAIM=Bits.Get<268,1>();
+  Aid.VirtualAid=Bits.Get<269,1>();
+  Aid.Assigned=Bits.Get<270,1>();
+
+  uint8_t ExtChars=(Bits.BitLen-272)/6;
+  if ( ExtChars>14 ) ExtChars=14;
+  if ( ExtChars>0 ) { // Trailing spaces of name belong to name, if there is extension
+    size_t n=strlen(Aid.Name);
+    memset(Aid.Name+n,' ',20-n);
+    Bits.GetText(272,ExtChars,Aid.Name+20);
+    for ( n=strlen(Aid.Name); n>0 && Aid.Name[n-1]==' '; n-- );
+    Aid.Name[n]=0;
+  }
+
+  return true;
+}
+
+//*****************************************************************************
+bool NMEA0183AISDecodeStaticDataReport(const tNMEA0183AISBits &Bits, tAISStaticDataReport &Report) {
+  if ( Bits.Get<0,6>()!=24 || Bits.BitLen<160 ) return false;
+
+  Report.Repeat=Bits.Get<6,2>();
+  Report.MMSI=Bits.Get<8,30>();
+  Report.PartNumber=Bits.Get<38,2>();
+  Report.Name[0]=0;
+  Report.ShipType=0;
+  Report.VendorID[0]=0;
+  Report.Model=0;
+  Report.Serial=0;
+  Report.CallSign[0]=0;
+  Report.ToBow=0;
+  Report.ToStern=0;
+  Report.ToPort=0;
+  Report.ToStarboard=0;
+  Report.MothershipMMSI=0;
+
+  if ( Report.PartNumber==0 ) {
+    Bits.GetText(40,20,Report.Name);
+  } else if ( Report.PartNumber==1 ) {
+    Report.ShipType=Bits.Get<40,8>();
+    Bits.GetText(48,3,Report.VendorID);
+    Report.Model=Bits.Get<66,4>();
+    Report.Serial=Bits.Get<70,20>();
+    Bits.GetText(90,7,Report.CallSign);
+    if ( Report.MMSI/10000000==98 ) {
+      Report.MothershipMMSI=Bits.Get<132,30>();
+    } else {
+      Report.ToBow=Bits.Get<132,9>();
+      Report.ToStern=Bits.Get<141,9>();
+      Report.ToPort=Bits.Get<150,6>();
+      Report.ToStarboard=Bits.Get<156,6>();
+    }
+  } else {
+    return false;
+  }
+
+  return true;
+}
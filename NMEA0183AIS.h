@@ -0,0 +1,244 @@
+/*
+NMEA0183AIS.h
+
+Copyright (c) 2015-2019 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+AIS payload decoder. Armored payload will be converted with lookup table to
+packed bit buffer, from which fields are read with bit getters specialized at
+compile time for field position and width. Message type can be read from the
+first payload character, so messages can be filtered before decoding.
+
+Decoded values are in AIS units to keep them exact:
+  - longitude and latitude in 1/10000 minutes (NMEA0183AISLatLonToDegrees)
+  - speed in 1/10 knots, course in 1/10 degrees, heading in degrees
+  - dimensions in meters and draught in 1/10 meters
+Text fields are null terminated with trailing '@' and spaces removed.
+
+  void HandleAISPayload(const tNMEA0183AISPayload &Payload, void *) {
+    tNMEA0183AISBits Bits;
+    tAISPositionReport Report;
+
+    if ( NMEA0183AISMessageType(Payload.Data)>3 ) return;
+    if ( NMEA0183AISDeArmor(Payload,Bits) && NMEA0183AISDecodePositionReport(Bits,Report) ) ...
+  }
+*/
+
+#ifndef _tNMEA0183_AIS_H_
+#define _tNMEA0183_AIS_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "NMEA0183AISReassembler.h"
+
+#define NMEA0183_AIS_MAX_BITS (NMEA0183_AIS_MAX_PAYLOAD_LEN*6)
+
+// Armor character to 6 bit value. Invalid characters are 0xff.
+extern const uint8_t NMEA0183AISArmorTable[128];
+
+//------------------------------------------------------------------------------
+// Bits are stored most significant first. Buffer has zero padding after data,
+// so getters need not check length and missing bits read as 0.
+struct tNMEA0183AISBits {
+  uint8_t Data[(NMEA0183_AIS_MAX_BITS+7)/8+8];
+  uint16_t BitLen;
+
+  // Get field of Width (1-32) bits starting from bit Start.
+  template<uint16_t Start, uint8_t Width> uint32_t Get() const {
+    static_assert(Width>=1 && Width<=32,"Invalid AIS field width");
+    static_assert(Start+Width<=NMEA0183_AIS_MAX_BITS,"AIS field out of buffer");
+    const uint8_t Bytes=(Start%8+Width+7)/8;
+    const uint8_t *p=Data+Start/8;
+    uint64_t v=0;
+    for ( uint8_t i=0; i<Bytes; i++ ) v=(v<<8) | p[i];
+    return (uint32_t)(v>>(Bytes*8-Start%8-Width)) & (uint32_t)(0xffffffffUL>>(32-Width));
+  }
+  // Get two's complement field.
+  template<uint16_t Start, uint8_t Width> int32_t GetSigned() const {
+    uint32_t v=Get<Start,Width>();
+    return (int32_t)(v<<(32-Width))>>(32-Width);
+  }
+  // Get field with run time position and width.
+  uint32_t Get(uint16_t Start, uint8_t Width) const;
+  // Get text of Chars 6 bit characters to Text, which must have room for Chars+1.
+  void GetText(uint16_t Start, uint8_t Chars, char *Text) const;
+};
+
+//*****************************************************************************
+// Message type from the first payload character. Returns 0 for invalid character.
+inline uint8_t NMEA0183AISMessageType(const char *Payload) {
+  uint8_t c=( Payload!=0 ? (uint8_t)Payload[0] : 0 );
+  return ( c<128 && NMEA0183AISArmorTable[c]!=0xff ? NMEA0183AISArmorTable[c] : 0 );
+}
+
+inline double NMEA0183AISLatLonToDegrees(int32_t val) { return val/600000.0; }
+
+//*****************************************************************************
+// Convert armored payload to bit buffer. Returns false for invalid character or too long payload.
+bool NMEA0183AISDeArmor(const char *Payload, uint16_t Len, uint8_t FillBits, tNMEA0183AISBits &Bits);
+
+inline bool NMEA0183AISDeArmor(const tNMEA0183AISPayload &Payload, tNMEA0183AISBits &Bits) {
+  return NMEA0183AISDeArmor(Payload.Data,Payload.Len,Payload.FillBits,Bits);
+}
+
+//*****************************************************************************
+// Types 1, 2 and 3
+struct tAISPositionReport {
+  uint8_t MessageType;
+  uint8_t Repeat;
+  uint32_t MMSI;
+  uint8_t NavStatus;
+  int8_t ROT;         // Raw rate of turn. -128 is not available.
+  uint16_t SOG;       // 1/10 knots. 1023 is not available.
+  bool Accuracy;
+  int32_t Longitude;  // 1/10000 minutes. 181 degrees is not available.
+  int32_t Latitude;   // 1/10000 minutes. 91 degrees is not available.
+  uint16_t COG;       // 1/10 degrees. 3600 is not available.
+  uint16_t Heading;   // Degrees. 511 is not available.
+  uint8_t Second;
+  uint8_t Maneuver;
+  bool RAIM;
+  uint32_t Radio;
+};
+
+bool NMEA0183AISDecodePositionReport(const tNMEA0183AISBits &Bits, tAISPositionReport &Report);
+
+//*****************************************************************************
+// Type 5
+struct tAISStaticVoyage {
+  uint8_t Repeat;
+  uint32_t MMSI;
+  uint8_t AISVersion;
+  uint32_t IMO;
+  char CallSign[8];
+  char Name[21];
+  uint8_t ShipType;
+  uint16_t ToBow;
+  uint16_t ToStern;
+  uint8_t ToPort;
+  uint8_t ToStarboard;
+  uint8_t EPFD;
+  uint8_t ETAMonth;
+  uint8_t ETADay;
+  uint8_t ETAHour;
+  uint8_t ETAMinute;
+  uint8_t Draught;    // 1/10 meters
+  char Destination[21];
+  bool DTE;
+};
+
+bool NMEA0183AISDecodeStaticVoyage(const tNMEA0183AISBits &Bits, tAISStaticVoyage &Voyage);
+
+//*****************************************************************************
+// Type 18
+struct tAISClassBPosition {
+  uint8_t Repeat;
+  uint32_t MMSI;
+  uint16_t SOG;
+  bool Accuracy;
+  int32_t Longitude;
+  int32_t Latitude;
+  uint16_t COG;
+  uint16_t Heading;
+  uint8_t Second;
+  bool CSUnit;
+  bool Display;
+  bool DSC;
+  bool Band;
+  bool Msg22;
+  bool Assigned;
+  bool RAIM;
+  uint32_t Radio;
+};
+
+bool NMEA0183AISDecodeClassBPosition(const tNMEA0183AISBits &Bits, tAISClassBPosition &Report);
+
+//*****************************************************************************
+// Type 19
+struct tAISExtendedClassB {
+  uint8_t Repeat;
+  uint32_t MMSI;
+  uint16_t SOG;
+  bool Accuracy;
+  int32_t Longitude;
+  int32_t Latitude;
+  uint16_t COG;
+  uint16_t Heading;
+  uint8_t Second;
+  char Name[21];
+  uint8_t ShipType;
+  uint16_t ToBow;
+  uint16_t ToStern;
+  uint8_t ToPort;
+  uint8_t ToStarboard;
+  uint8_t EPFD;
+  bool RAIM;
+  bool DTE;
+  bool Assigned;
+};
+
+bool NMEA0183AISDecodeExtendedClassB(const tNMEA0183AISBits &Bits, tAISExtendedClassB &Report);
+
+//*****************************************************************************
+// Type 21
+struct tAISAidToNavigation {
+  uint8_t Repeat;
+  uint32_t MMSI;
+  uint8_t AidType;
+  char Name[35];      // Name and name extension
+  bool Accuracy;
+  int32_t Longitude;
+  int32_t Latitude;
+  uint16_t ToBow;
+  uint16_t ToStern;
+  uint8_t ToPort;
+  uint8_t ToStarboard;
+  uint8_t EPFD;
+  uint8_t Second;
+  bool OffPosition;
+  bool RAIM;
+  bool VirtualAid;
+  bool Assigned;
+};
+
+bool NMEA0183AISDecodeAidToNavigation(const tNMEA0183AISBits &Bits, tAISAidToNavigation &Aid);
+
+//*****************************************************************************
+// Type 24. Part A has only name. Part B has the rest. For auxiliary craft
+// (MMSI 98xxxxxxx) part B has MothershipMMSI instead of dimensions.
+struct tAISStaticDataReport {
+  uint8_t Repeat;
+  uint32_t MMSI;
+  uint8_t PartNumber;
+  char Name[21];
+  uint8_t ShipType;
+  char VendorID[4];
+  uint8_t Model;
+  uint32_t Serial;
+  char CallSign[8];
+  uint16_t ToBow;
+  uint16_t ToStern;
+  uint8_t ToPort;
+  uint8_t ToStarboard;
+  uint32_t MothershipMMSI;
+};
+
+bool NMEA0183AISDecodeStaticDataReport(const tNMEA0183AISBits &Bits, tAISStaticDataReport &Report);
+
+#endif
@@ -0,0 +1,177 @@
+/*
+NMEA0183AISReassembler.cpp
+
+Copyright (c) 2015-2019 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#include <string.h>
+#include "NMEA0183AISReassembler.h"
+#include "NMEA0183FieldParser.h"
+
+//*****************************************************************************
+tNMEA0183AISReassembler::tNMEA0183AISReassembler(tNMEA0183AISPayloadHandler _Handler, void *_Context, unsigned long _Timeout)
+: Handler(_Handler), Context(_Context), Timeout(_Timeout) {
+  Clear();
+}
+
+//*****************************************************************************
+void tNMEA0183AISReassembler::Clear() {
+  for ( uint8_t i=0; i<NMEA0183_AIS_REASSEMBLY_SLOTS; i++ ) Slots[i].Key=NoSlot;
+  memset(Lookup,NoSlot,sizeof(Lookup));
+  CompletedCount=0;
+  DroppedCount=0;
+}
+
+//*****************************************************************************
+void tNMEA0183AISReassembler::FreeSlot(uint8_t Slot) {
+  Lookup[Slots[Slot].Key]=NoSlot;
+  Slots[Slot].Key=NoSlot;
+}
+
+//*****************************************************************************
+uint8_t tNMEA0183AISReassembler::AllocSlot(unsigned long Now) {
+  uint8_t Oldest=0;
+
+  for ( uint8_t i=0; i<NMEA0183_AIS_REASSEMBLY_SLOTS; i++ ) {
+    if ( Slots[i].Key==NoSlot ) return i;
+    if ( Now-Slots[i].Started>Now-Slots[Oldest].Started ) Oldest=i;
+  }
+
+  FreeSlot(Oldest);
+  DroppedCount++;
+
+  return Oldest;
+}
+
+//*****************************************************************************
+void tNMEA0183AISReassembler::EvictStale(unsigned long Now) {
+  for ( uint8_t i=0; i<NMEA0183_AIS_REASSEMBLY_SLOTS; i++ ) {
+    if ( Slots[i].Key!=NoSlot && Now-Slots[i].Started>Timeout ) {
+      FreeSlot(i);
+      DroppedCount++;
+    }
+  }
+}
+
+//*****************************************************************************
+uint8_t tNMEA0183AISReassembler::PendingCount() const {
+  uint8_t Count=0;
+
+  for ( uint8_t i=0; i<NMEA0183_AIS_REASSEMBLY_SLOTS; i++ ) {
+    if ( Slots[i].Key!=NoSlot ) Count++;
+  }
+
+  return Count;
+}
+
+//*****************************************************************************
+void tNMEA0183AISReassembler::Deliver(const char *Data, uint16_t Len, uint8_t FillBits, char Channel, bool Own, uint8_t SourceID) {
+  tNMEA0183AISPayload Payload;
+
+  CompletedCount++;
+  if ( Handler==0 ) return;
+
+  Payload.Data=Data;
+  Payload.Len=Len;
+  Payload.FillBits=FillBits;
+  Payload.Channel=Channel;
+  Payload.Own=Own;
+  Payload.SourceID=SourceID;
+  Handler(Payload,Context);
+}
+
+//*****************************************************************************
+// !AIVDM,2,1,3,B,55P5TL01VIaAL@7WKO@mBplU@<PDhh000000001S;AJ::4A80?4i@E53,0*3E
+bool tNMEA0183AISReassembler::Add(const tNMEA0183MsgView &NMEA0183Msg) {
+  bool Own;
+  int32_t Count, Number, FillBits;
+
+  switch ( NMEA0183Msg.MessageCodeId() ) {
+    case NMEA0183MsgCodeId("VDM"): Own=false; break;
+    case NMEA0183MsgCodeId("VDO"): Own=true; break;
+    default: return false;
+  }
+  if ( NMEA0183Msg.FieldCount()<6 ) return false;
+  if ( !NMEA0183FieldToInt32(NMEA0183Msg.Field(0),NMEA0183Msg.FieldLen(0),Count) ||
+       !NMEA0183FieldToInt32(NMEA0183Msg.Field(1),NMEA0183Msg.FieldLen(1),Number) ||
+       Count<1 || Count>9 || Number<1 || Number>Count ) return false;
+  if ( !NMEA0183FieldToInt32(NMEA0183Msg.Field(5),NMEA0183Msg.FieldLen(5),FillBits) || FillBits<0 || FillBits>5 ) FillBits=0;
+
+  uint8_t PayloadLen=NMEA0183Msg.FieldLen(4);
+  if ( PayloadLen>NMEA0183_AIS_MAX_PAYLOAD_LEN ) return false;
+
+  char Channel=NMEA0183Msg.FieldChar(3);
+  if ( Channel=='1' ) Channel='A';
+  if ( Channel=='2' ) Channel='B';
+
+  if ( Count==1 ) { // Single sentence message needs no slot
+    Deliver(NMEA0183Msg.Field(4),PayloadLen,FillBits,Channel,Own,NMEA0183Msg.SourceID);
+    return true;
+  }
+
+  uint8_t SeqId=SeqIds-1;
+  char c=NMEA0183Msg.FieldChar(2);
+  if ( c>='0' && c<='9' ) {
+    SeqId=c-'0';
+  } else if ( c!=0 ) {
+    return false;
+  }
+  uint8_t ChannelIndex=( Channel=='A' ? 0 : Channel=='B' ? 1 : 2 );
+  uint8_t Key=((Own ? 1 : 0)*SeqIds+SeqId)*Channels+ChannelIndex;
+  unsigned long Now=NMEA0183Msg.MessageTime();
+  uint8_t Slot=Lookup[Key];
+
+  if ( Slot!=NoSlot && ( Number==1 || Now-Slots[Slot].Started>Timeout ||
+                         Slots[Slot].Count!=Count || Slots[Slot].Next!=Number ) ) {
+    // Restarted, stale or lost fragment
+    FreeSlot(Slot);
+    DroppedCount++;
+    Slot=NoSlot;
+  }
+
+  if ( Slot==NoSlot ) {
+    if ( Number!=1 ) return false;
+    Slot=AllocSlot(Now);
+    Slots[Slot].Key=Key;
+    Slots[Slot].Count=Count;
+    Slots[Slot].Next=1;
+    Slots[Slot].Len=0;
+    Slots[Slot].Started=Now;
+    Lookup[Key]=Slot;
+  }
+
+  tSlot &Fragments=Slots[Slot];
+  if ( Fragments.Len+PayloadLen>NMEA0183_AIS_MAX_PAYLOAD_LEN ) {
+    FreeSlot(Slot);
+    DroppedCount++;
+    return false;
+  }
+  memcpy(Fragments.Data+Fragments.Len,NMEA0183Msg.Field(4),PayloadLen);
+  Fragments.Len+=PayloadLen;
+  Fragments.Next++;
+
+  if ( Number==Count ) {
+    Deliver(Fragments.Data,Fragments.Len,FillBits,Channel,Own,NMEA0183Msg.SourceID);
+    FreeSlot(Slot);
+  }
+
+  return true;
+}
@@ -0,0 +1,127 @@
+/*
+NMEA0183AISReassembler.h
+
+Copyright (c) 2015-2019 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+Reassembler for multi sentence AIS VDM and VDO messages. Fragments are
+collected to fixed size slots, which are found directly by sequential message
+id and channel. Partial messages older than timeout will be evicted, when slot
+is needed or on EvictStale. Payload of single sentence message is given to
+handler directly from message without copying. Fragments of multi sentence
+message are copied once to slot.
+
+Use one reassembler for each receiver, since fragments are not separated by
+source.
+
+  tNMEA0183AISReassembler AIS(HandleAISPayload);
+  tNMEA0183HandlerTableT<> Handlers;
+  NMEA0183.SetMsgHandlerTable(&Handlers);
+  NMEA0183.AddMsgHandlerId(NMEA0183MsgCodeVDM,tNMEA0183AISReassembler::MsgHandler,&AIS);
+*/
+
+#ifndef _tNMEA0183_AIS_REASSEMBLER_H_
+#define _tNMEA0183_AIS_REASSEMBLER_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "NMEA0183MsgView.h"
+
+// Count of messages, which can be reassembled at same time.
+#ifndef NMEA0183_AIS_REASSEMBLY_SLOTS
+#if defined(__AVR__)
+#define NMEA0183_AIS_REASSEMBLY_SLOTS 2
+#else
+#define NMEA0183_AIS_REASSEMBLY_SLOTS 16
+#endif
+#endif
+
+// Max armored payload length. Longest AIS message has 1008 bits = 168 characters.
+#ifndef NMEA0183_AIS_MAX_PAYLOAD_LEN
+#define NMEA0183_AIS_MAX_PAYLOAD_LEN 168
+#endif
+
+#ifndef NMEA0183_AIS_REASSEMBLY_TIMEOUT
+#define NMEA0183_AIS_REASSEMBLY_TIMEOUT 2000
+#endif
+
+struct tNMEA0183AISPayload {
+  const char *Data;   // Armored payload. Not null terminated.
+  uint16_t Len;
+  uint8_t FillBits;
+  char Channel;       // 'A', 'B' or 0
+  bool Own;           // Message was VDO
+  uint8_t SourceID;
+};
+
+typedef void (*tNMEA0183AISPayloadHandler)(const tNMEA0183AISPayload &Payload, void *Context);
+
+//------------------------------------------------------------------------------
+class tNMEA0183AISReassembler
+{
+  protected:
+    static const uint8_t NoSlot=0xff;
+    static const uint8_t SeqIds=11;     // 0-9 and missing id
+    static const uint8_t Channels=3;    // A, B and other
+
+    struct tSlot {
+      char Data[NMEA0183_AIS_MAX_PAYLOAD_LEN];
+      uint16_t Len;
+      uint8_t Key;            // Index on Lookup, NoSlot for free slot
+      uint8_t Count;          // Count of fragments
+      uint8_t Next;           // Next expected fragment number
+      unsigned long Started;  // Message time of first fragment
+    };
+
+    tNMEA0183AISPayloadHandler Handler;
+    void *Context;
+    unsigned long Timeout;
+    tSlot Slots[NMEA0183_AIS_REASSEMBLY_SLOTS];
+    uint8_t Lookup[2*SeqIds*Channels];
+    uint32_t CompletedCount;
+    uint32_t DroppedCount;
+
+  protected:
+    void FreeSlot(uint8_t Slot);
+    // Find free slot. Stale or oldest partial message will be evicted, if needed.
+    uint8_t AllocSlot(unsigned long Now);
+    void Deliver(const char *Data, uint16_t Len, uint8_t FillBits, char Channel, bool Own, uint8_t SourceID);
+
+  public:
+    tNMEA0183AISReassembler(tNMEA0183AISPayloadHandler _Handler=0, void *_Context=0, unsigned long _Timeout=NMEA0183_AIS_REASSEMBLY_TIMEOUT);
+    void SetHandler(tNMEA0183AISPayloadHandler _Handler, void *_Context=0) { Handler=_Handler; Context=_Context; }
+    void SetTimeout(unsigned long _Timeout) { Timeout=_Timeout; }
+    // Add VDM or VDO sentence. Handler will be called, when message is complete.
+    // Returns false, if message is not valid AIS sentence or fragment was out of order.
+    bool Add(const tNMEA0183MsgView &NMEA0183Msg);
+    // Evict partial messages older than timeout.
+    void EvictStale(unsigned long Now);
+    void Clear();
+    uint8_t PendingCount() const;
+    uint32_t Completed() const { return CompletedCount; }
+    // Partial messages, which were evicted or broken by lost fragment.
+    uint32_t Dropped() const { return DroppedCount; }
+
+    // Handler for tNMEA0183::AddMsgHandler. Context must be reassembler.
+    static void MsgHandler(const tNMEA0183MsgView &NMEA0183Msg, void *Reassembler) {
+      ((tNMEA0183AISReassembler *)Reassembler)->Add(NMEA0183Msg);
+    }
+};
+
+#endif
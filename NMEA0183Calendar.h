@@ -0,0 +1,85 @@
+/*
+NMEA0183Calendar.h
+
+Copyright (c) 2015-2019 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+Civil calendar conversions with pure integer arithmetic. Functions do not
+depend on time zone or libc time functions and can be evaluated at compile
+time. Days are counted from 1.1.1970 on proleptic Gregorian calendar.
+Algorithms are from Howard Hinnant's "chrono-Compatible Low-Level Date
+Algorithms". Years are counted in eras of 400 years starting from March,
+so leap day is last day of year.
+*/
+
+#ifndef _tNMEA0183_CALENDAR_H_
+#define _tNMEA0183_CALENDAR_H_
+
+#include <stdint.h>
+
+#define NMEA0183_DAYS_PER_ERA 146097L
+#define NMEA0183_DAYS_0000_03_01_TO_1970 719468L
+
+struct tNMEA0183Date {
+  int16_t Year;
+  uint8_t Month;  // 1..12
+  uint8_t Day;    // 1..31
+};
+
+// Helpers for functions below. C++11 constexpr function can only have return statement.
+constexpr int32_t NMEA0183Era(int32_t Year) { return ( Year>=0 ? Year : Year-399 )/400; }
+constexpr uint32_t NMEA0183DayOfMarchYear(uint8_t Month, uint8_t Day) { return (153UL*(Month>2 ? Month-3 : Month+9)+2)/5+Day-1; }
+constexpr uint32_t NMEA0183DayOfEra(uint32_t YearOfEra, uint32_t DayOfYear) { return YearOfEra*365+YearOfEra/4-YearOfEra/100+DayOfYear; }
+constexpr int32_t NMEA0183DaysFromMarchYear(int32_t Year, uint8_t Month, uint8_t Day) {
+  return NMEA0183Era(Year)*NMEA0183_DAYS_PER_ERA
+         +(int32_t)NMEA0183DayOfEra((uint32_t)(Year-NMEA0183Era(Year)*400),NMEA0183DayOfMarchYear(Month,Day))
+         -NMEA0183_DAYS_0000_03_01_TO_1970;
+}
+
+//*****************************************************************************
+// Days since 1.1.1970 for date. Month is 1..12 and Day 1..31.
+constexpr int32_t NMEA0183DaysFromCivil(int32_t Year, uint8_t Month, uint8_t Day) {
+  return NMEA0183DaysFromMarchYear(( Month<=2 ? Year-1 : Year ),Month,Day);
+}
+
+// Helpers for NMEA0183CivilFromDays.
+constexpr int32_t NMEA0183DaysEra(int32_t Days) { return ( Days>=0 ? Days : Days-(NMEA0183_DAYS_PER_ERA-1) )/NMEA0183_DAYS_PER_ERA; }
+constexpr uint32_t NMEA0183YearOfEra(uint32_t DayOfEra) { return (DayOfEra-DayOfEra/1460+DayOfEra/36524-DayOfEra/146096)/365; }
+constexpr uint32_t NMEA0183MarchMonth(uint32_t DayOfYear) { return (5*DayOfYear+2)/153; }
+constexpr uint8_t NMEA0183CivilMonth(uint32_t MarchMonth) { return (uint8_t)( MarchMonth<10 ? MarchMonth+3 : MarchMonth-9 ); }
+constexpr tNMEA0183Date NMEA0183MakeDate(int32_t MarchYear, uint32_t DayOfYear) {
+  return tNMEA0183Date{ (int16_t)(MarchYear+(NMEA0183CivilMonth(NMEA0183MarchMonth(DayOfYear))<=2 ? 1 : 0)),
+                        NMEA0183CivilMonth(NMEA0183MarchMonth(DayOfYear)),
+                        (uint8_t)(DayOfYear-(153*NMEA0183MarchMonth(DayOfYear)+2)/5+1) };
+}
+constexpr tNMEA0183Date NMEA0183DateFromDayOfEra(int32_t Era, uint32_t DayOfEra) {
+  return NMEA0183MakeDate((int32_t)NMEA0183YearOfEra(DayOfEra)+Era*400,
+                          DayOfEra-NMEA0183DayOfEra(NMEA0183YearOfEra(DayOfEra),0));
+}
+constexpr tNMEA0183Date NMEA0183CivilFromMarchDays(int32_t Days) {
+  return NMEA0183DateFromDayOfEra(NMEA0183DaysEra(Days),(uint32_t)(Days-NMEA0183DaysEra(Days)*NMEA0183_DAYS_PER_ERA));
+}
+
+//*****************************************************************************
+// Date for days since 1.1.1970.
+constexpr tNMEA0183Date NMEA0183CivilFromDays(int32_t Days) {
+  return NMEA0183CivilFromMarchDays(Days+NMEA0183_DAYS_0000_03_01_TO_1970);
+}
+
+#endif
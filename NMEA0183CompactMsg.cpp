@@ -0,0 +1,159 @@
+/*
+NMEA0183CompactMsg.cpp
+
+Copyright (c) 2015-2019 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#include <string.h>
+#include "NMEA0183CompactMsg.h"
+
+//*****************************************************************************
+size_t NMEA0183CompactEncode(const tNMEA0183Msg &NMEA0183Msg, uint8_t *buf, size_t BufSize) {
+  size_t len=NMEA0183Msg.ImageLen();
+
+  if ( buf==0 || len>0xff || NMEA0183_COMPACT_HEADER_LEN+len>BufSize ) return 0;
+
+  uint32_t Time=NMEA0183Msg.MessageTime();
+  buf[0]=len;
+  buf[1]=NMEA0183Msg.GetPrefix();
+  buf[2]=NMEA0183Msg.SourceID;
+  buf[3]=NMEA0183Msg.GetCheckSum();
+  buf[4]=Time; buf[5]=Time>>8; buf[6]=Time>>16; buf[7]=Time>>24;
+  memcpy(buf+NMEA0183_COMPACT_HEADER_LEN,NMEA0183Msg.Image(),len);
+
+  return NMEA0183_COMPACT_HEADER_LEN+len;
+}
+
+//*****************************************************************************
+size_t NMEA0183CompactRecordSize(const uint8_t *buf, size_t len) {
+  if ( buf==0 || len<NMEA0183_COMPACT_HEADER_LEN || NMEA0183_COMPACT_HEADER_LEN+(size_t)buf[0]>len ) return 0;
+
+  return NMEA0183_COMPACT_HEADER_LEN+buf[0];
+}
+
+//*****************************************************************************
+static inline uint32_t CompactTime(const uint8_t *buf) {
+  return (uint32_t)buf[4] | ((uint32_t)buf[5]<<8) | ((uint32_t)buf[6]<<16) | ((uint32_t)buf[7]<<24);
+}
+
+//*****************************************************************************
+bool NMEA0183CompactDecode(const uint8_t *buf, size_t len, tNMEA0183Msg &NMEA0183Msg) {
+  if ( NMEA0183CompactRecordSize(buf,len)==0 ) { NMEA0183Msg.Clear(); return false; }
+
+  if ( !NMEA0183Msg.SetImage((const char *)buf+NMEA0183_COMPACT_HEADER_LEN,buf[0],buf[1],buf[3],CompactTime(buf)) ) return false;
+  NMEA0183Msg.SourceID=buf[2];
+
+  return true;
+}
+
+//*****************************************************************************
+bool NMEA0183CompactDecode(const uint8_t *buf, size_t len, tNMEA0183MsgView &NMEA0183Msg) {
+  if ( NMEA0183CompactRecordSize(buf,len)==0 ) { NMEA0183Msg.Clear(); return false; }
+
+  if ( !NMEA0183Msg.SetImage((const char *)buf+NMEA0183_COMPACT_HEADER_LEN,buf[0],buf[1],buf[3],CompactTime(buf)) ) return false;
+  NMEA0183Msg.SourceID=buf[2];
+
+  return true;
+}
+
+//*****************************************************************************
+tNMEA0183CompactBuffer::tNMEA0183CompactBuffer(uint8_t *_Buf, size_t _Size)
+: Buf(_Buf), Size(_Buf!=0?_Size:0), DroppedCount(0) {
+  Clear();
+}
+
+//*****************************************************************************
+void tNMEA0183CompactBuffer::Clear() {
+  ReadPos=0;
+  WritePos=0;
+  WrapPos=0;
+  Wrapped=false;
+  _Count=0;
+  _Used=0;
+}
+
+//*****************************************************************************
+// Record is never split. If it does not fit to end of buffer, it will be written
+// to start and WrapPos tells where records on end of buffer ends.
+uint8_t *tNMEA0183CompactBuffer::Reserve(size_t len) {
+  if ( _Count==0 ) Clear();
+
+  if ( Wrapped ) {
+    if ( ReadPos-WritePos<len ) return 0;
+  } else if ( Size-WritePos<len ) {
+    if ( ReadPos<len ) return 0;
+    WrapPos=WritePos;
+    WritePos=0;
+    Wrapped=true;
+  }
+
+  return Buf+WritePos;
+}
+
+//*****************************************************************************
+bool tNMEA0183CompactBuffer::Push(const tNMEA0183Msg &NMEA0183Msg, bool DropOldest) {
+  size_t len=NMEA0183CompactSize(NMEA0183Msg);
+  if ( len>Size ) return false;
+
+  uint8_t *Record;
+  while ( (Record=Reserve(len))==0 ) {
+    if ( !DropOldest || !Pop() ) return false;
+    DroppedCount++;
+  }
+
+  NMEA0183CompactEncode(NMEA0183Msg,Record,len);
+  WritePos+=len;
+  _Count++;
+  _Used+=len;
+
+  return true;
+}
+
+//*****************************************************************************
+bool tNMEA0183CompactBuffer::Peek(tNMEA0183MsgView &NMEA0183Msg) const {
+  if ( _Count==0 ) { NMEA0183Msg.Clear(); return false; }
+
+  return NMEA0183CompactDecode(Buf+ReadPos,Size-ReadPos,NMEA0183Msg);
+}
+
+//*****************************************************************************
+bool tNMEA0183CompactBuffer::Peek(tNMEA0183Msg &NMEA0183Msg) const {
+  if ( _Count==0 ) { NMEA0183Msg.Clear(); return false; }
+
+  return NMEA0183CompactDecode(Buf+ReadPos,Size-ReadPos,NMEA0183Msg);
+}
+
+//*****************************************************************************
+bool tNMEA0183CompactBuffer::Pop() {
+  if ( _Count==0 ) return false;
+
+  size_t len=NMEA0183_COMPACT_HEADER_LEN+Buf[ReadPos];
+  ReadPos+=len;
+  _Used-=len;
+  _Count--;
+  if ( Wrapped && ReadPos>=WrapPos ) {
+    ReadPos=0;
+    Wrapped=false;
+  }
+  if ( _Count==0 ) Clear();
+
+  return true;
+}
@@ -0,0 +1,120 @@
+/*
+NMEA0183CompactMsg.h
+
+Copyright (c) 2015-2019 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+Compact variable length record of validated message for backlogs and replay
+buffers. Record has 8 byte header and message data image (see
+tNMEA0183Msg::Image), so e.g. HDT takes 23 bytes instead of full
+tNMEA0183Msg. Field positions are not stored. They will be rebuilt, when record
+is decoded to message or view.
+
+Record: image length, prefix, source id, checksum, message time as 4 byte
+little endian and image.
+
+tNMEA0183CompactBuffer is FIFO of records on fixed buffer. Records are kept
+contiguous, so they can be read as views without copying.
+
+  tNMEA0183CompactBufferT<4096> Backlog;
+  Backlog.Push(NMEA0183Msg,true);   // Drop oldest, if full
+  ...
+  tNMEA0183MsgView View;
+  while ( Backlog.Peek(View) ) { Send(View); Backlog.Pop(); }
+*/
+
+#ifndef _tNMEA0183_COMPACT_MSG_H_
+#define _tNMEA0183_COMPACT_MSG_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "NMEA0183Msg.h"
+#include "NMEA0183MsgView.h"
+
+#define NMEA0183_COMPACT_HEADER_LEN 8
+
+// Size of record for message.
+inline size_t NMEA0183CompactSize(const tNMEA0183Msg &NMEA0183Msg) { return NMEA0183_COMPACT_HEADER_LEN+NMEA0183Msg.ImageLen(); }
+// Encode message to buf. Returns size of record or 0, if it does not fit to BufSize.
+size_t NMEA0183CompactEncode(const tNMEA0183Msg &NMEA0183Msg, uint8_t *buf, size_t BufSize);
+// Size of record on buf or 0, if len is too short for record.
+size_t NMEA0183CompactRecordSize(const uint8_t *buf, size_t len);
+// Decode record to message or view. View points to record, which must stay unchanged as
+// long as view is used.
+bool NMEA0183CompactDecode(const uint8_t *buf, size_t len, tNMEA0183Msg &NMEA0183Msg);
+bool NMEA0183CompactDecode(const uint8_t *buf, size_t len, tNMEA0183MsgView &NMEA0183Msg);
+
+//------------------------------------------------------------------------------
+class tNMEA0183CompactBuffer
+{
+  protected:
+    uint8_t *Buf;
+    size_t Size;
+    size_t ReadPos;
+    size_t WritePos;
+    size_t WrapPos;   // End of records on end of buffer, when Wrapped
+    bool Wrapped;     // Records continue from buffer start to WritePos
+    size_t _Count;
+    size_t _Used;
+    uint32_t DroppedCount;
+
+    // Reserve contiguous room for record. Returns 0, if there is no room.
+    uint8_t *Reserve(size_t len);
+
+  public:
+    tNMEA0183CompactBuffer(uint8_t *_Buf, size_t _Size);
+    // Add message to buffer. If DropOldest is set, oldest records will be removed to
+    // get room. Returns false, if message does not fit.
+    bool Push(const tNMEA0183Msg &NMEA0183Msg, bool DropOldest=false);
+    // Read oldest message without removing it. View is valid until Pop or Clear.
+    bool Peek(tNMEA0183MsgView &NMEA0183Msg) const;
+    bool Peek(tNMEA0183Msg &NMEA0183Msg) const;
+    // Remove oldest message.
+    bool Pop();
+    // Read and remove oldest message. Returns false, if buffer is empty or message does not
+    // fit to NMEA0183Msg. Record will be removed also in latter case.
+    bool Pop(tNMEA0183Msg &NMEA0183Msg) {
+      if ( IsEmpty() ) return false;
+      bool Ret=Peek(NMEA0183Msg);
+      Pop();
+      return Ret;
+    }
+    void Clear();
+    bool IsEmpty() const { return _Count==0; }
+    size_t Count() const { return _Count; }
+    // Bytes used by records.
+    size_t Used() const { return _Used; }
+    size_t Capacity() const { return Size; }
+    // Records removed by Push with DropOldest.
+    uint32_t Dropped() const { return DroppedCount; }
+};
+
+//------------------------------------------------------------------------------
+// Compact buffer with storage inside object.
+template <size_t BufSize>
+class tNMEA0183CompactBufferT : public tNMEA0183CompactBuffer
+{
+  protected:
+    uint8_t Storage[BufSize];
+
+  public:
+    tNMEA0183CompactBufferT() : tNMEA0183CompactBuffer(Storage,BufSize) {}
+};
+
+#endif
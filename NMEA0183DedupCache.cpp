@@ -0,0 +1,129 @@
+/*
+NMEA0183DedupCache.cpp
+
+Copyright (c) 2015-2019 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#include "NMEA0183DedupCache.h"
+
+#define FNV_OFFSET 2166136261UL
+#define FNV_PRIME 16777619UL
+
+//*****************************************************************************
+static inline uint32_t HashBytes(uint32_t h, const char *data, size_t len) {
+  for ( size_t i=0; i<len; i++ ) {
+    h^=(uint8_t)data[i];
+    h*=FNV_PRIME;
+  }
+
+  return h;
+}
+
+//*****************************************************************************
+// Mix checksum and spread bits, since table index uses low bits.
+static inline uint32_t FinishHash(uint32_t h, uint8_t CheckSum) {
+  h^=CheckSum;
+  h^=h>>16;
+  h*=0x85ebca6bUL;
+  h^=h>>13;
+
+  return ( h!=0 ? h : 1 );
+}
+
+//*****************************************************************************
+// Data image has sender, message code and fields terminated with null.
+uint32_t tNMEA0183DedupCache::Hash(const tNMEA0183Msg &NMEA0183Msg) {
+  char Prefix=NMEA0183Msg.GetPrefix();
+  uint32_t h=HashBytes(FNV_OFFSET,&Prefix,1);
+
+  h=HashBytes(h,NMEA0183Msg.Image(),NMEA0183Msg.ImageLen());
+
+  return FinishHash(h,NMEA0183Msg.GetCheckSum());
+}
+
+//*****************************************************************************
+// Hash same bytes as data image of tNMEA0183Msg would have.
+uint32_t tNMEA0183DedupCache::Hash(const tNMEA0183MsgView &NMEA0183Msg) {
+  static const char Null=0;
+  char Prefix=NMEA0183Msg.GetPrefix();
+  uint32_t h=HashBytes(FNV_OFFSET,&Prefix,1);
+
+  h=HashBytes(h,NMEA0183Msg.Sender(),2);
+  h=HashBytes(h,&Null,1);
+  h=HashBytes(h,NMEA0183Msg.MessageCode(),NMEA0183Msg.MessageCodeLen());
+  h=HashBytes(h,&Null,1);
+  for ( uint8_t i=0; i<NMEA0183Msg.FieldCount(); i++ ) {
+    h=HashBytes(h,NMEA0183Msg.Field(i),NMEA0183Msg.FieldLen(i));
+    h=HashBytes(h,&Null,1);
+  }
+
+  return FinishHash(h,NMEA0183Msg.GetCheckSum());
+}
+
+//*****************************************************************************
+tNMEA0183DedupCache::tNMEA0183DedupCache(unsigned long _Window) : Window(_Window) {
+  Clear();
+}
+
+//*****************************************************************************
+void tNMEA0183DedupCache::Clear() {
+  for ( size_t i=0; i<NMEA0183_DEDUP_SLOTS; i++ ) {
+    Entries[i].Hash=0;
+    Entries[i].Time=0;
+  }
+  DuplicateCount=0;
+  PassedCount=0;
+}
+
+//*****************************************************************************
+// Entries are never removed, only replaced. So never used entry ends probing,
+// since no entry with same hash can be after it. New entry replaces first
+// expired entry or the oldest one on probed slots.
+bool tNMEA0183DedupCache::IsDuplicate(uint32_t Hash, unsigned long Now) {
+  tEntry *Free=0;
+  tEntry *Oldest=0;
+
+  for ( size_t i=0; i<NMEA0183_DEDUP_MAX_PROBE; i++ ) {
+    tEntry *Entry=&Entries[(Hash+i) & (NMEA0183_DEDUP_SLOTS-1)];
+    if ( Entry->Hash==0 ) {
+      if ( Free==0 ) Free=Entry;
+      break;
+    }
+    // Other port may have given slightly older time for its message.
+    bool Expired=( Now-Entry->Time>=Window && Entry->Time-Now>=Window );
+    if ( Entry->Hash==Hash && !Expired ) {
+      DuplicateCount++;
+      return true;
+    }
+    if ( Expired ) {
+      if ( Free==0 ) Free=Entry;
+    } else if ( Oldest==0 || Now-Entry->Time>Now-Oldest->Time ) {
+      Oldest=Entry;
+    }
+  }
+
+  if ( Free==0 ) Free=Oldest;
+  Free->Hash=Hash;
+  Free->Time=Now;
+  PassedCount++;
+
+  return false;
+}
@@ -0,0 +1,103 @@
+/*
+NMEA0183DedupCache.h
+
+Copyright (c) 2015-2019 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+Duplicate sentence suppression for redundant sources. Cache keeps hash of
+sentence body and checksum with time, when it was first seen. Same sentence
+seen again within time window is duplicate. Table has fixed size and uses open
+addressing with bounded probing, so check is O(1) and does not allocate.
+Entries expire by time and will be reused.
+
+Time of entry will not be renewed by duplicates, so source sending the same
+sentence periodically will pass once per period, if window is shorter than
+period.
+
+Check messages between GetMessage and dispatch. Use same cache for all ports,
+which may receive the same sentences:
+
+  tNMEA0183DedupCache Dedup(500);
+  tNMEA0183Msg Msg;
+  while ( GNSS1.GetMessage(Msg) ) if ( !Dedup.IsDuplicate(Msg) ) GNSS1.DispatchMessage(Msg);
+  while ( GNSS2.GetMessage(Msg) ) if ( !Dedup.IsDuplicate(Msg) ) GNSS1.DispatchMessage(Msg);
+*/
+
+#ifndef _tNMEA0183_DEDUP_CACHE_H_
+#define _tNMEA0183_DEDUP_CACHE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "NMEA0183Msg.h"
+#include "NMEA0183MsgView.h"
+
+// Count of entries. Must be power of two.
+#ifndef NMEA0183_DEDUP_SLOTS
+#if defined(__AVR__)
+#define NMEA0183_DEDUP_SLOTS 16
+#else
+#define NMEA0183_DEDUP_SLOTS 256
+#endif
+#endif
+
+// Max slots checked for one hash.
+#ifndef NMEA0183_DEDUP_MAX_PROBE
+#define NMEA0183_DEDUP_MAX_PROBE 8
+#endif
+
+#ifndef NMEA0183_DEDUP_WINDOW
+#define NMEA0183_DEDUP_WINDOW 1000
+#endif
+
+//------------------------------------------------------------------------------
+class tNMEA0183DedupCache
+{
+  static_assert((NMEA0183_DEDUP_SLOTS & (NMEA0183_DEDUP_SLOTS-1))==0,"NMEA0183_DEDUP_SLOTS must be power of two");
+
+  protected:
+    struct tEntry {
+      uint32_t Hash;       // 0 for never used entry
+      unsigned long Time;  // Time, when sentence was first seen
+    };
+
+    unsigned long Window;
+    tEntry Entries[NMEA0183_DEDUP_SLOTS];
+    uint32_t DuplicateCount;
+    uint32_t PassedCount;
+
+  public:
+    tNMEA0183DedupCache(unsigned long _Window=NMEA0183_DEDUP_WINDOW);
+    void SetWindow(unsigned long _Window) { Window=_Window; }
+    // Returns true, if same sentence has been seen within window before Now. Otherwise
+    // sentence will be added to cache and false returned.
+    bool IsDuplicate(uint32_t Hash, unsigned long Now);
+    // Message time will be used as Now.
+    bool IsDuplicate(const tNMEA0183Msg &NMEA0183Msg) { return IsDuplicate(Hash(NMEA0183Msg),NMEA0183Msg.MessageTime()); }
+    bool IsDuplicate(const tNMEA0183MsgView &NMEA0183Msg) { return IsDuplicate(Hash(NMEA0183Msg),NMEA0183Msg.MessageTime()); }
+    void Clear();
+    uint32_t Duplicates() const { return DuplicateCount; }
+    uint32_t Passed() const { return PassedCount; }
+
+    // Hash of prefix, sender, message code, fields and checksum. Message and view of the
+    // same sentence have same hash. Hash is never 0.
+    static uint32_t Hash(const tNMEA0183Msg &NMEA0183Msg);
+    static uint32_t Hash(const tNMEA0183MsgView &NMEA0183Msg);
+};
+
+#endif
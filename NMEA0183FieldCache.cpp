@@ -0,0 +1,111 @@
+/*
+NMEA0183FieldCache.cpp
+
+Copyright (c) 2015-2019 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#include "NMEA0183FieldCache.h"
+#include "NMEA0183FieldParser.h"
+
+//*****************************************************************************
+const tNMEA0183FieldCache::tEntry *tNMEA0183FieldCache::Find(uint8_t Index, uint8_t Kind, char Sign) const {
+  for ( uint8_t i=0; i<Count; i++ ) {
+    const tEntry &Entry=Entries[i];
+    if ( Entry.Index==Index && Entry.Kind==Kind && Entry.Sign==Sign ) return &Entry;
+  }
+
+  return 0;
+}
+
+//*****************************************************************************
+tNMEA0183FieldCache::tEntry &tNMEA0183FieldCache::Add(uint8_t Index, uint8_t Kind, char Sign) {
+  uint8_t i;
+
+  if ( Count<NMEA0183_FIELD_CACHE_SIZE ) {
+    i=Count;
+    Count++;
+  } else {
+    i=Next;
+    Next=(Next+1)%NMEA0183_FIELD_CACHE_SIZE;
+  }
+  tEntry &Entry=Entries[i];
+  Entry.Index=Index;
+  Entry.Kind=Kind;
+  Entry.Sign=Sign;
+
+  return Entry;
+}
+
+//*****************************************************************************
+bool tNMEA0183FieldCache::GetDouble(uint8_t Index, const char *data, size_t len, double &val) {
+  const tEntry *Entry=Find(Index,Kind_Double);
+
+  if ( Entry==0 ) {
+    tEntry &New=Add(Index,Kind_Double);
+    New.Valid=NMEA0183FieldToDouble(data,len,New.Value.Double);
+    Entry=&New;
+  }
+  val=Entry->Value.Double;
+
+  return Entry->Valid;
+}
+
+//*****************************************************************************
+bool tNMEA0183FieldCache::GetInt32(uint8_t Index, const char *data, size_t len, int32_t &val) {
+  const tEntry *Entry=Find(Index,Kind_Int32);
+
+  if ( Entry==0 ) {
+    tEntry &New=Add(Index,Kind_Int32);
+    New.Valid=NMEA0183FieldToInt32(data,len,New.Value.Int32);
+    Entry=&New;
+  }
+  val=Entry->Value.Int32;
+
+  return Entry->Valid;
+}
+
+//*****************************************************************************
+bool tNMEA0183FieldCache::GetLatLon(uint8_t Index, const char *data, size_t len, char Sign, double &val) {
+  const tEntry *Entry=Find(Index,Kind_LatLon,Sign);
+
+  if ( Entry==0 ) {
+    tEntry &New=Add(Index,Kind_LatLon,Sign);
+    New.Valid=NMEA0183FieldToLatLon(data,len,Sign,New.Value.Double);
+    Entry=&New;
+  }
+  val=Entry->Value.Double;
+
+  return Entry->Valid;
+}
+
+//*****************************************************************************
+bool tNMEA0183FieldCache::GetTime(uint8_t Index, const char *data, size_t len, double &val) {
+  const tEntry *Entry=Find(Index,Kind_Time);
+
+  if ( Entry==0 ) {
+    tEntry &New=Add(Index,Kind_Time);
+    New.Valid=NMEA0183FieldToSeconds(data,len,New.Value.Double);
+    Entry=&New;
+  }
+  val=Entry->Value.Double;
+
+  return Entry->Valid;
+}
@@ -0,0 +1,121 @@
+/*
+NMEA0183FieldCache.h
+
+Copyright (c) 2015-2019 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+Small cache for decoded message fields. tNMEA0183CachedFields uses it to
+give typed field accessors for a message or view, so that each field will be
+parsed at most once and only when someone asks it. Cache is owned by caller
+and not by message, so messages stay small and can be read from several
+threads. Cache has fixed size and oldest entry will be replaced, when it is
+full. Failed parsing (e.g. empty field) will be cached too.
+
+  tNMEA0183CachedFields<tNMEA0183Msg> Fields(NMEA0183Msg);
+  double SOG=Fields.Get<double>(6);
+*/
+
+#ifndef _tNMEA0183_FIELD_CACHE_H_
+#define _tNMEA0183_FIELD_CACHE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "NMEA0183Msg.h"
+
+#ifndef NMEA0183_FIELD_CACHE_SIZE
+#if defined(__AVR__)
+#define NMEA0183_FIELD_CACHE_SIZE 4
+#else
+#define NMEA0183_FIELD_CACHE_SIZE 8
+#endif
+#endif
+
+//------------------------------------------------------------------------------
+class tNMEA0183FieldCache
+{
+  protected:
+    enum tKind { Kind_Double=0, Kind_Int32=1, Kind_LatLon=2, Kind_Time=3 };
+    struct tEntry {
+      uint8_t Index;
+      uint8_t Kind;
+      char Sign;   // Sign character for Kind_LatLon
+      bool Valid;
+      union {
+        double Double;
+        int32_t Int32;
+      } Value;
+    };
+    tEntry Entries[NMEA0183_FIELD_CACHE_SIZE];
+    uint8_t Count;
+    uint8_t Next;  // Entry to be replaced next, when cache is full
+
+    const tEntry *Find(uint8_t Index, uint8_t Kind, char Sign=0) const;
+    tEntry &Add(uint8_t Index, uint8_t Kind, char Sign=0);
+
+  public:
+    tNMEA0183FieldCache() : Count(0), Next(0) {}
+    void Clear() { Count=0; Next=0; }
+    // Functions return cached value for field Index or parse it from data with length len.
+    // Return false, if field is empty or invalid.
+    bool GetDouble(uint8_t Index, const char *data, size_t len, double &val);
+    bool GetInt32(uint8_t Index, const char *data, size_t len, int32_t &val);
+    // Latitude or longitude in degrees. Sign is first character of sign field.
+    bool GetLatLon(uint8_t Index, const char *data, size_t len, char Sign, double &val);
+    // Time in seconds since midnight.
+    bool GetTime(uint8_t Index, const char *data, size_t len, double &val);
+};
+
+//------------------------------------------------------------------------------
+// Cached typed field accessors for tNMEA0183Msg or tNMEA0183MsgView. Message must
+// not change or go out of scope while accessor is used. Call SetMessage after
+// message has been changed.
+template <class tMsg> class tNMEA0183CachedFields
+{
+  protected:
+    const tMsg *Msg;
+    tNMEA0183FieldCache Cache;
+
+    double GetValue(uint8_t index, double *) {
+      double val;
+      return ( Cache.GetDouble(index,Msg->Field(index),Msg->FieldLen(index),val)?val:NMEA0183DoubleNA );
+    }
+    int32_t GetValue(uint8_t index, int32_t *) {
+      int32_t val;
+      return ( Cache.GetInt32(index,Msg->Field(index),Msg->FieldLen(index),val)?val:NMEA0183Int32NA );
+    }
+
+  public:
+    tNMEA0183CachedFields(const tMsg &_Msg) : Msg(&_Msg) {}
+    void SetMessage(const tMsg &_Msg) { Msg=&_Msg; Cache.Clear(); }
+    const tMsg &Message() const { return *Msg; }
+
+    // See tNMEA0183Msg::Get. Supports double and int32_t.
+    template <typename T> T Get(uint8_t index) { return GetValue(index,(T *)0); }
+    double GetLatLon(uint8_t index, uint8_t SignIndex) {
+      double val;
+      char Sign=( Msg->FieldLen(SignIndex)>0?Msg->Field(SignIndex)[0]:0 );
+      return ( Cache.GetLatLon(index,Msg->Field(index),Msg->FieldLen(index),Sign,val)?val:NMEA0183DoubleNA );
+    }
+    double GetTime(uint8_t index) {
+      double val;
+      return ( Cache.GetTime(index,Msg->Field(index),Msg->FieldLen(index),val)?val:NMEA0183DoubleNA );
+    }
+};
+
+#endif
@@ -0,0 +1,200 @@
+/*
+NMEA0183FieldFormatter.cpp
+
+Copyright (c) 2015-2019 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#include <string.h>
+#include <math.h>
+#include "NMEA0183FieldFormatter.h"
+
+// Value scaled by decimals must fit to integer.
+#if defined(__AVR__)
+typedef uint32_t tFormatUInt;
+#define NMEA0183_MAX_FORMAT_DECIMALS 7
+#else
+typedef uint64_t tFormatUInt;
+#define NMEA0183_MAX_FORMAT_DECIMALS 15
+#endif
+
+#define NMEA0183_FORMAT_TMP_LEN 32
+
+static const double Pow10[]={1e0,1e1,1e2,1e3,1e4,1e5,1e6,1e7,1e8,1e9,1e10,1e11,1e12,1e13,1e14,1e15};
+
+//*****************************************************************************
+tNMEA0183NumFormat NMEA0183NumFormat(const char *Format) {
+  tNMEA0183NumFormat NumFormat(1,0);
+  if ( Format==0 ) return NumFormat;
+
+  for ( ; *Format!=0 && *Format!='%'; Format++ );
+  if ( *Format==0 ) return NumFormat;
+  Format++;
+
+  uint8_t Width=0;
+  for ( ; *Format>='0' && *Format<='9'; Format++ ) Width=Width*10+(*Format-'0');
+  NumFormat.Width=Width;
+
+  // printf default precision is 6
+  NumFormat.Decimals=6;
+  if ( *Format=='.' ) {
+    uint8_t Decimals=0;
+    for ( Format++; *Format>='0' && *Format<='9'; Format++ ) Decimals=Decimals*10+(*Format-'0');
+    NumFormat.Decimals=Decimals;
+  }
+
+  return NumFormat;
+}
+
+//*****************************************************************************
+// Digits are collected backwards to the end of tmp and then copied to buf.
+static size_t CopyDigits(char *buf, size_t BufSize, const char *tmpEnd, size_t len) {
+  if ( buf==0 || len+1>BufSize ) return 0;
+
+  memcpy(buf,tmpEnd-len,len);
+  buf[len]=0;
+
+  return len;
+}
+
+//*****************************************************************************
+static char *PutDigits(char *p, tFormatUInt val, uint8_t MinDigits) {
+  for ( uint8_t i=0; val!=0 || i<MinDigits; i++ ) {
+    *(--p)='0'+(char)(val%10);
+    val/=10;
+  }
+
+  return p;
+}
+
+//*****************************************************************************
+size_t NMEA0183FormatDouble(char *buf, size_t BufSize, double val, const tNMEA0183NumFormat &Format) {
+  if ( val!=val ) return 0; // NaN
+
+  uint8_t Decimals=( Format.Decimals<NMEA0183_MAX_FORMAT_DECIMALS ? Format.Decimals : NMEA0183_MAX_FORMAT_DECIMALS );
+  bool Negative=( val<0 );
+  if ( Negative ) val=-val;
+
+  double Scaled=val*Pow10[Decimals];
+  if ( !(Scaled<(double)((tFormatUInt)1<<(sizeof(tFormatUInt)*8-1))) ) return 0; // Too big or infinite
+  tFormatUInt n=(tFormatUInt)Scaled;
+  double Rest=Scaled-(double)n;
+  if ( Rest>0.5 ) {
+    n++;
+  } else if ( Rest==0.5 ) {
+    // Product may have been rounded to tie. Check rounding error of it as printf
+    // rounds exact decimal value of val. Real ties are rounded to even.
+    double Err=fma(val,Pow10[Decimals],-Scaled);
+    if ( Err>0 || (Err==0 && (n & 1)!=0) ) n++;
+  }
+  if ( n==0 ) Negative=false; // Do not print -0.0
+
+  char tmp[NMEA0183_FORMAT_TMP_LEN];
+  char *end=tmp+NMEA0183_FORMAT_TMP_LEN;
+  char *p=end;
+
+  if ( Decimals>0 ) {
+    tFormatUInt Div=(tFormatUInt)Pow10[Decimals];
+    p=PutDigits(p,n%Div,Decimals);
+    *(--p)='.';
+    n/=Div;
+  }
+  uint8_t Width=( Format.Width<NMEA0183_FORMAT_TMP_LEN-1 ? Format.Width : NMEA0183_FORMAT_TMP_LEN-1 );
+  uint8_t MinDigits=1;
+  size_t len=(end-p)+(Negative?1:0);
+  if ( Width>len+1 ) MinDigits=Width-len;
+  p=PutDigits(p,n,MinDigits);
+  if ( Negative ) *(--p)='-';
+
+  return CopyDigits(buf,BufSize,end,end-p);
+}
+
+//*****************************************************************************
+size_t NMEA0183FormatUInt32(char *buf, size_t BufSize, uint32_t val, uint8_t Width) {
+  char tmp[NMEA0183_FORMAT_TMP_LEN];
+  char *end=tmp+NMEA0183_FORMAT_TMP_LEN;
+
+  if ( Width>NMEA0183_FORMAT_TMP_LEN ) Width=NMEA0183_FORMAT_TMP_LEN;
+  char *p=PutDigits(end,val,(Width>0?Width:1));
+
+  return CopyDigits(buf,BufSize,end,end-p);
+}
+
+//*****************************************************************************
+size_t NMEA0183FormatFixed(char *buf, size_t BufSize, int32_t val, uint8_t Decimals, uint8_t Width) {
+  char tmp[NMEA0183_FORMAT_TMP_LEN];
+  char *end=tmp+NMEA0183_FORMAT_TMP_LEN;
+  char *p=end;
+  bool Negative=( val<0 );
+  uint32_t n=( Negative ? 0UL-(uint32_t)val : (uint32_t)val );
+
+  if ( Decimals>9 ) return 0;
+  if ( Decimals>0 ) {
+    uint32_t Div=(uint32_t)Pow10[Decimals];
+    p=PutDigits(p,n%Div,Decimals);
+    *(--p)='.';
+    n/=Div;
+  }
+  if ( Width>NMEA0183_FORMAT_TMP_LEN-1 ) Width=NMEA0183_FORMAT_TMP_LEN-1;
+  uint8_t MinDigits=1;
+  size_t len=(end-p)+(Negative?1:0);
+  if ( Width>len+1 ) MinDigits=Width-len;
+  p=PutDigits(p,n,MinDigits);
+  if ( Negative ) *(--p)='-';
+
+  return CopyDigits(buf,BufSize,end,end-p);
+}
+
+//*****************************************************************************
+// Remainder of degrees in 1e-7 degrees multiplied by 6 gives minutes in 1e-6 minutes
+// without overflow. Rounding may carry minutes to next degree.
+size_t NMEA0183FormatLatLonE7(char *buf, size_t BufSize, int32_t val, uint8_t DegDigits, uint8_t Decimals) {
+  char tmp[NMEA0183_FORMAT_TMP_LEN];
+  char *end=tmp+NMEA0183_FORMAT_TMP_LEN;
+  char *p=end;
+  uint32_t n=( val<0 ? 0UL-(uint32_t)val : (uint32_t)val );
+
+  if ( Decimals>6 ) Decimals=6;
+  uint32_t Div=(uint32_t)Pow10[6-Decimals];
+  uint32_t Scale=(uint32_t)Pow10[Decimals];
+  uint32_t Deg=n/10000000UL;
+  uint32_t Minutes=((n%10000000UL)*6+Div/2)/Div;
+  if ( Minutes>=60*Scale ) {
+    Minutes-=60*Scale;
+    Deg++;
+  }
+
+  if ( Decimals>0 ) {
+    p=PutDigits(p,Minutes%Scale,Decimals);
+    *(--p)='.';
+  }
+  p=PutDigits(p,Minutes/Scale,2);
+  p=PutDigits(p,Deg,DegDigits);
+
+  return CopyDigits(buf,BufSize,end,end-p);
+}
+
+//*****************************************************************************
+void NMEA0183FormatHexByte(char *buf, uint8_t val) {
+  static const char HexDigits[]="0123456789ABCDEF";
+
+  buf[0]=HexDigits[val>>4];
+  buf[1]=HexDigits[val & 0x0f];
+}
@@ -0,0 +1,72 @@
+/*
+NMEA0183FieldFormatter.h
+
+Copyright (c) 2015-2019 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+Number formatters for building NMEA0183 fields. Formatters use integer
+arithmetic and write directly to given buffer, so printf with double support
+is not needed. Format is given with tNMEA0183NumFormat instead of printf format.
+*/
+
+#ifndef _tNMEA0183_FIELD_FORMATTER_H_
+#define _tNMEA0183_FIELD_FORMATTER_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Fixed decimals number format. Number will be padded with leading zeros to Width
+// characters like printf %0<Width>.<Decimals>f does.
+struct tNMEA0183NumFormat {
+  uint8_t Decimals;
+  uint8_t Width;
+
+  constexpr tNMEA0183NumFormat(uint8_t _Decimals=1, uint8_t _Width=0) : Decimals(_Decimals), Width(_Width) {}
+};
+
+//*****************************************************************************
+// Convert printf format like "%.1f" or "%09.2f" to tNMEA0183NumFormat.
+tNMEA0183NumFormat NMEA0183NumFormat(const char *Format);
+
+//*****************************************************************************
+// Write val to buf with null termination. Returns count of written characters
+// without null termination or 0, if number does not fit to BufSize or can not
+// be formatted.
+size_t NMEA0183FormatDouble(char *buf, size_t BufSize, double val, const tNMEA0183NumFormat &Format);
+
+//*****************************************************************************
+// As above for unsigned integer with minimum width.
+size_t NMEA0183FormatUInt32(char *buf, size_t BufSize, uint32_t val, uint8_t Width=0);
+
+//*****************************************************************************
+// Write fixed point value val/10^Decimals like -12345,3 -> "-12.345" padded with
+// leading zeros to Width.
+size_t NMEA0183FormatFixed(char *buf, size_t BufSize, int32_t val, uint8_t Decimals, uint8_t Width=0);
+
+//*****************************************************************************
+// Write absolute value of latitude or longitude given in 1e-7 degrees to format
+// ddmm.mmmm or dddmm.mmmm. DegDigits is 2 for latitude and 3 for longitude. Max 6
+// decimals will be used.
+size_t NMEA0183FormatLatLonE7(char *buf, size_t BufSize, int32_t val, uint8_t DegDigits, uint8_t Decimals);
+
+//*****************************************************************************
+// Write val as two upper case hex digits without null termination.
+void NMEA0183FormatHexByte(char *buf, uint8_t val);
+
+#endif
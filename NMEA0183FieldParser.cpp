@@ -0,0 +1,226 @@
+/*
+NMEA0183FieldParser.cpp
+
+Copyright (c) 2015-2019 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#include "NMEA0183FieldParser.h"
+
+// Mantissa is collected to integer. When mantissa and power of ten are both exact
+// doubles, single division gives correctly rounded result as strtod.
+#if defined(__AVR__)
+typedef uint32_t tMantissa;
+#define NMEA0183_MAX_MANTISSA_DIGITS 9
+#else
+typedef uint64_t tMantissa;
+#define NMEA0183_MAX_MANTISSA_DIGITS 19
+#endif
+
+static const double Pow10[]={1e0,1e1,1e2,1e3,1e4,1e5,1e6,1e7,1e8,1e9,1e10,1e11,
+                             1e12,1e13,1e14,1e15,1e16,1e17,1e18,1e19,1e20,1e21,1e22};
+
+struct tDecimal {
+  tMantissa Int;      // Integer part
+  tMantissa Frac;     // Fraction digits as integer
+  int8_t FracDigits;  // Count of used fraction digits
+  int8_t IntScale;    // Count of integer digits, which did not fit to Int
+  bool Negative;
+};
+
+//*****************************************************************************
+static double ScalePow10(double val, int exp) {
+  for ( ; exp>22; exp-=22 ) val*=Pow10[22];
+  for ( ; exp<-22; exp+=22 ) val/=Pow10[22];
+
+  return ( exp>=0 ? val*Pow10[exp] : val/Pow10[-exp] );
+}
+
+//*****************************************************************************
+// Parse [spaces][sign]digits[.digits]. Returns false, if there was no digits.
+static bool ParseDecimal(const char *data, size_t len, tDecimal &Dec) {
+  const char *end=data+len;
+  uint8_t Digits=0;
+  bool HasDigits=false;
+
+  Dec.Int=0; Dec.Frac=0; Dec.FracDigits=0; Dec.IntScale=0; Dec.Negative=false;
+
+  for ( ; data<end && *data==' '; data++ ); // Pass spaces
+  if ( data<end && (*data=='-' || *data=='+') ) {
+    Dec.Negative=(*data=='-');
+    data++;
+  }
+
+  for ( ; data<end && *data>='0' && *data<='9'; data++ ) {
+    HasDigits=true;
+    if ( Digits<NMEA0183_MAX_MANTISSA_DIGITS ) {
+      Dec.Int=Dec.Int*10+(*data-'0');
+      if ( Dec.Int!=0 ) Digits++;
+    } else {
+      Dec.IntScale++;
+    }
+  }
+
+  if ( data<end && *data=='.' ) {
+    for ( data++; data<end && *data>='0' && *data<='9'; data++ ) {
+      HasDigits=true;
+      if ( Digits<NMEA0183_MAX_MANTISSA_DIGITS && Dec.FracDigits<22 ) {
+        Dec.Frac=Dec.Frac*10+(*data-'0');
+        Dec.FracDigits++;
+        if ( Dec.Int!=0 || Dec.Frac!=0 ) Digits++;
+      }
+    }
+  }
+
+  return HasDigits;
+}
+
+//*****************************************************************************
+bool NMEA0183FieldToDouble(const char *data, size_t len, double &val) {
+  tDecimal Dec;
+
+  if ( data==0 || !ParseDecimal(data,len,Dec) ) return false;
+
+  if ( Dec.IntScale>0 ) {
+    val=ScalePow10((double)Dec.Int,Dec.IntScale);
+  } else {
+    // Int and Frac together have max NMEA0183_MAX_MANTISSA_DIGITS significant digits.
+    tMantissa Mantissa=Dec.Int;
+    for ( int8_t i=0; i<Dec.FracDigits; i++ ) Mantissa*=10;
+    val=ScalePow10((double)(Mantissa+Dec.Frac),-Dec.FracDigits);
+  }
+  if ( Dec.Negative ) val=-val;
+
+  return true;
+}
+
+//*****************************************************************************
+bool NMEA0183FieldToInt32(const char *data, size_t len, int32_t &val) {
+  tDecimal Dec;
+
+  if ( data==0 || !ParseDecimal(data,len,Dec) ) return false;
+
+  val=(int32_t)Dec.Int;
+  if ( Dec.Negative ) val=-val;
+
+  return true;
+}
+
+//*****************************************************************************
+// Degrees are on integer part over minutes, so they can be separated without rounding.
+bool NMEA0183FieldToLatLon(const char *data, size_t len, char sign, double &val) {
+  tDecimal Dec;
+
+  if ( data==0 || !ParseDecimal(data,len,Dec) || Dec.IntScale>0 ) return false;
+
+  tMantissa Minutes=Dec.Int%100;
+  for ( int8_t i=0; i<Dec.FracDigits; i++ ) Minutes*=10;
+  val=(double)(Dec.Int/100)+ScalePow10((double)(Minutes+Dec.Frac),-Dec.FracDigits)/60.0;
+  if ( Dec.Negative ) val=-val;
+  if ( sign=='S' || sign=='W' ) val=-val;
+
+  return true;
+}
+
+//*****************************************************************************
+bool NMEA0183FieldToSeconds(const char *data, size_t len, double &val) {
+  tDecimal Dec;
+
+  if ( data==0 || !ParseDecimal(data,len,Dec) || Dec.IntScale>0 ) return false;
+
+  uint32_t hhmmss=(uint32_t)Dec.Int;
+  uint32_t Seconds=(hhmmss/10000)*3600UL+((hhmmss/100)%100)*60UL+hhmmss%100;
+  val=(double)Seconds+ScalePow10((double)Dec.Frac,-Dec.FracDigits);
+  if ( Dec.Negative ) val=-val;
+
+  return true;
+}
+
+static const uint32_t Pow10Int[]={1UL,10UL,100UL,1000UL,10000UL,100000UL,1000000UL,10000000UL,100000000UL,1000000000UL};
+
+//*****************************************************************************
+// Scale fraction digits to Decimals. Returns 0 or 1 for rounding.
+static uint8_t ScaleFrac(const tDecimal &Dec, uint8_t Decimals, uint32_t &Frac) {
+  tMantissa f=Dec.Frac;
+  uint8_t RoundUp=0;
+  int8_t FracDigits=Dec.FracDigits;
+
+  for ( ; FracDigits>Decimals; FracDigits-- ) { // Last loop drops the first extra digit
+    RoundUp=( f%10>=5 ? 1 : 0 );
+    f/=10;
+  }
+  for ( ; FracDigits<Decimals; FracDigits++ ) f*=10;
+  Frac=(uint32_t)f;
+
+  return RoundUp;
+}
+
+//*****************************************************************************
+bool NMEA0183FieldToFixed(const char *data, size_t len, uint8_t Decimals, int32_t &val) {
+  tDecimal Dec;
+
+  if ( data==0 || Decimals>9 || !ParseDecimal(data,len,Dec) || Dec.IntScale>0 ) return false;
+  if ( Dec.Int>0x7fffffffUL/Pow10Int[Decimals] ) return false;
+
+  uint32_t Frac;
+  uint8_t RoundUp=ScaleFrac(Dec,Decimals,Frac);
+  uint32_t Fixed=(uint32_t)Dec.Int*Pow10Int[Decimals];
+  if ( Frac+RoundUp>0x7fffffffUL-Fixed ) return false;
+  Fixed+=Frac+RoundUp;
+  val=( Dec.Negative ? -(int32_t)Fixed : (int32_t)Fixed );
+
+  return true;
+}
+
+//*****************************************************************************
+// Minutes are scaled to 1e-7 minutes, which still fits to uint32_t. Then 1e-7 degrees
+// is just minutes/60.
+bool NMEA0183FieldToLatLonE7(const char *data, size_t len, char sign, int32_t &val) {
+  tDecimal Dec;
+
+  if ( data==0 || !ParseDecimal(data,len,Dec) || Dec.IntScale>0 ) return false;
+
+  uint32_t Deg=(uint32_t)(Dec.Int/100);
+  if ( Deg>180 ) return false;
+
+  uint32_t Frac;
+  uint8_t RoundUp=ScaleFrac(Dec,7,Frac);
+  uint32_t Minutes=(uint32_t)(Dec.Int%100)*10000000UL+Frac+RoundUp;
+  int32_t Fixed=(int32_t)(Deg*10000000UL+(Minutes+30)/60);
+  if ( Dec.Negative ) Fixed=-Fixed;
+  if ( sign=='S' || sign=='W' ) Fixed=-Fixed;
+  val=Fixed;
+
+  return true;
+}
+
+//*****************************************************************************
+bool NMEA0183FieldToMilliSeconds(const char *data, size_t len, uint32_t &val) {
+  tDecimal Dec;
+
+  if ( data==0 || !ParseDecimal(data,len,Dec) || Dec.IntScale>0 || Dec.Negative ) return false;
+
+  uint32_t hhmmss=(uint32_t)Dec.Int;
+  uint32_t Frac;
+  uint8_t RoundUp=ScaleFrac(Dec,3,Frac);
+  val=((hhmmss/10000)*3600UL+((hhmmss/100)%100)*60UL+hhmmss%100)*1000UL+Frac+RoundUp;
+
+  return true;
+}
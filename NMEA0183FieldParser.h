@@ -0,0 +1,67 @@
+/*
+NMEA0183FieldParser.h
+
+Copyright (c) 2015-2019 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+Number parsers for NMEA0183 fields. Parsers work on field pointer and length,
+so fields need not to be null terminated. Parsers do not depend on locale and
+do not allocate memory. Empty or invalid field is reported by returning false.
+Parsing stops on first character, which does not belong to number, like atof does.
+*/
+
+#ifndef _tNMEA0183_FIELD_PARSER_H_
+#define _tNMEA0183_FIELD_PARSER_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+//*****************************************************************************
+// Parse decimal number like "-12.345". Returns false for empty field.
+bool NMEA0183FieldToDouble(const char *data, size_t len, double &val);
+
+//*****************************************************************************
+// Parse integer like "-12". Returns false for empty field.
+bool NMEA0183FieldToInt32(const char *data, size_t len, int32_t &val);
+
+//*****************************************************************************
+// Parse latitude or longitude in format dddmm.mmmm to degrees. Sign 'S' or 'W'
+// gives negative value. Returns false for empty field.
+bool NMEA0183FieldToLatLon(const char *data, size_t len, char sign, double &val);
+
+//*****************************************************************************
+// Parse time in format hhmmss.ss to seconds since midnight. Returns false for empty field.
+bool NMEA0183FieldToSeconds(const char *data, size_t len, double &val);
+
+//*****************************************************************************
+// Parse decimal number to integer scaled by 10^Decimals like "-12.345",3 -> -12345.
+// Extra decimals will be rounded. Fixed point parsers use only integer arithmetic.
+// Returns false for empty field or if value does not fit.
+bool NMEA0183FieldToFixed(const char *data, size_t len, uint8_t Decimals, int32_t &val);
+
+//*****************************************************************************
+// Parse latitude or longitude in format dddmm.mmmm to 1e-7 degrees. Conversion
+// is exact except final rounding.
+bool NMEA0183FieldToLatLonE7(const char *data, size_t len, char sign, int32_t &val);
+
+//*****************************************************************************
+// Parse time in format hhmmss.sss to milliseconds since midnight.
+bool NMEA0183FieldToMilliSeconds(const char *data, size_t len, uint32_t &val);
+
+#endif
@@ -0,0 +1,190 @@
+/*
+NMEA0183FileStream.cpp
+
+Copyright (c) 2015-2019 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#if defined(__linux__)||defined(__linux)||defined(linux)
+
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "NMEA0183FileStream.h"
+#include "NMEA0183FieldParser.h"
+
+//*****************************************************************************
+tNMEA0183FileStream::tNMEA0183FileStream()
+: Data(0), Size(0), Pos(0), ReleasedEnd(0), Paced(false), Speed(1.0), HasFirstTime(false), FirstTime(0) {
+  memset(&StartTime,0,sizeof(StartTime));
+}
+
+//*****************************************************************************
+tNMEA0183FileStream::~tNMEA0183FileStream() {
+  Close();
+}
+
+//*****************************************************************************
+bool tNMEA0183FileStream::Open(const char *FileName) {
+  struct stat st;
+
+  Close();
+  if ( FileName==0 ) return false;
+
+  int fd=open(FileName,O_RDONLY | O_CLOEXEC);
+  if ( fd==-1 ) return false;
+  if ( fstat(fd,&st)!=0 || st.st_size<=0 ) { close(fd); return false; }
+
+  void *Map=mmap(0,st.st_size,PROT_READ,MAP_PRIVATE,fd,0);
+  close(fd); // Mapping keeps file
+  if ( Map==MAP_FAILED ) return false;
+  madvise(Map,st.st_size,MADV_SEQUENTIAL);
+
+  Data=(const uint8_t *)Map;
+  Size=st.st_size;
+  Rewind();
+
+  return true;
+}
+
+//*****************************************************************************
+void tNMEA0183FileStream::Close() {
+  if ( Data!=0 ) munmap((void *)Data,Size);
+  Data=0;
+  Size=0;
+  Rewind();
+}
+
+//*****************************************************************************
+void tNMEA0183FileStream::Rewind() {
+  Pos=0;
+  ReleasedEnd=0;
+  HasFirstTime=false;
+}
+
+//*****************************************************************************
+void tNMEA0183FileStream::SetPaced(bool _Paced, double _Speed) {
+  Paced=_Paced;
+  Speed=( _Speed>0 ? _Speed : 1.0 );
+  HasFirstTime=false;
+}
+
+//*****************************************************************************
+bool tNMEA0183FileStream::LineTime(const uint8_t *Line, size_t len, double &Time) const {
+  const char *p=(const char *)Line;
+  const char *end=p+len;
+
+  if ( p<end && *p=='\\' ) { // TAG block. Find c: field
+    const char *BlockEnd=(const char *)memchr(p+1,'\\',end-(p+1));
+    if ( BlockEnd==0 ) return false;
+    for ( p++; p<BlockEnd; p++ ) {
+      if ( p+2<BlockEnd && p[0]=='c' && p[1]==':' ) break;
+      const char *Next=(const char *)memchr(p,',',BlockEnd-p);
+      if ( Next==0 ) return false;
+      p=Next;
+    }
+    if ( p>=BlockEnd ) return false;
+    p+=2;
+    end=BlockEnd;
+  } else {
+    for ( ; p<end && *p==' '; p++ );
+    if ( p>=end || *p<'0' || *p>'9' ) return false;
+  }
+
+  if ( !NMEA0183FieldToDouble(p,end-p,Time) ) return false;
+  if ( Time>1e11 ) Time/=1000.0;
+
+  return true;
+}
+
+//*****************************************************************************
+size_t tNMEA0183FileStream::Release() {
+  if ( !Paced ) {
+    ReleasedEnd=Size;
+  } else if ( ReleasedEnd<=Pos ) {
+    struct timespec Now;
+    clock_gettime(CLOCK_MONOTONIC,&Now);
+    double Elapsed=0;
+    if ( HasFirstTime ) {
+      Elapsed=(Now.tv_sec-StartTime.tv_sec)+(Now.tv_nsec-StartTime.tv_nsec)*1e-9;
+    }
+
+    while ( ReleasedEnd<Size ) {
+      const uint8_t *Line=Data+ReleasedEnd;
+      const uint8_t *LineEnd=(const uint8_t *)memchr(Line,'\n',Size-ReleasedEnd);
+      size_t len=( LineEnd!=0 ? LineEnd+1-Line : Size-ReleasedEnd );
+      double Time;
+
+      if ( LineTime(Line,len,Time) ) {
+        if ( !HasFirstTime ) {
+          HasFirstTime=true;
+          FirstTime=Time;
+          StartTime=Now;
+        } else if ( (Time-FirstTime)/Speed>Elapsed ) {
+          break;
+        }
+      }
+      ReleasedEnd+=len;
+    }
+  }
+
+  return ReleasedEnd-Pos;
+}
+
+//*****************************************************************************
+int tNMEA0183FileStream::available() {
+  if ( Data==0 ) return 0;
+
+  size_t Available=Release();
+  return ( Available<0x7fffffff ? (int)Available : 0x7fffffff );
+}
+
+//*****************************************************************************
+int tNMEA0183FileStream::read() {
+  if ( Data==0 || Release()==0 ) return -1;
+
+  return Data[Pos++];
+}
+
+//*****************************************************************************
+size_t tNMEA0183FileStream::read(uint8_t *buf, size_t len) {
+  const uint8_t *Span;
+
+  len=readSpan(Span,len);
+  if ( len>0 ) memcpy(buf,Span,len);
+
+  return len;
+}
+
+//*****************************************************************************
+size_t tNMEA0183FileStream::readSpan(const uint8_t *&data, size_t len) {
+  data=Data+Pos;
+  if ( Data==0 ) return 0;
+
+  size_t Available=Release();
+  if ( len>Available ) len=Available;
+  Pos+=len;
+
+  return len;
+}
+
+#endif
@@ -0,0 +1,91 @@
+/*
+NMEA0183FileStream.h
+
+Copyright (c) 2015-2019 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+Inherited tNMEA0183Stream object for reading NMEA0183 log files on Linux.
+File will be memory mapped and given to tNMEA0183 as spans without copying.
+Stream can also replay log in recorded pace. Pacing uses time stamp in start
+of line, which can be either number like "1697040000.123 $GPGGA,..." or NMEA
+TAG block "\c:1697040000*hh\$GPGGA,...". Time stamp is in seconds, or in
+milliseconds, if it is over 1e11. Lines without time stamp will be given
+with previous line.
+
+  tNMEA0183FileStream Log;
+  tNMEA0183 NMEA0183(&Log);
+
+  Log.Open("nmea.log");
+  Log.SetPaced(true);
+  NMEA0183.Open();
+  while ( !Log.eof() ) NMEA0183.ParseMessages();
+*/
+
+#ifndef _NMEA0183_FILE_STREAM_H_
+#define _NMEA0183_FILE_STREAM_H_
+
+#include "NMEA0183Stream.h"
+
+#if defined(__linux__)||defined(__linux)||defined(linux)
+
+#include <time.h>
+
+//-----------------------------------------------------------------------------
+class tNMEA0183FileStream : public tNMEA0183Stream {
+protected:
+  const uint8_t *Data;
+  size_t Size;
+  size_t Pos;
+  size_t ReleasedEnd; // Data up to this has been released for reading
+  bool Paced;
+  double Speed;
+  bool HasFirstTime;
+  double FirstTime;
+  struct timespec StartTime;
+
+  // Parse time stamp in start of line. Returns false, if line does not have it.
+  bool LineTime(const uint8_t *Line, size_t len, double &Time) const;
+  // Move ReleasedEnd over lines, which are due. Returns count of bytes to read.
+  size_t Release();
+public:
+    tNMEA0183FileStream();
+    virtual ~tNMEA0183FileStream();
+    bool Open(const char *FileName);
+    void Close();
+    bool IsOpen() const { return Data!=0; }
+    // Start from the beginning. Pacing will be restarted too.
+    void Rewind();
+    // Replay in recorded pace. Speed 2.0 replays twice as fast.
+    void SetPaced(bool _Paced, double _Speed=1.0);
+    size_t FileSize() const { return Size; }
+    size_t Position() const { return Pos; }
+    bool eof() const { return Pos>=Size; }
+
+    int available();
+    int availableForWrite() { return 0; }
+    int read();
+    size_t read(uint8_t *buf, size_t len);
+    size_t readSpan(const uint8_t *&data, size_t len);
+    using tNMEA0183Stream::write;
+    // Log file is read only.
+    size_t write(const uint8_t* data, size_t size) { (void)data; (void)size; return 0; }
+};
+#endif
+
+#endif
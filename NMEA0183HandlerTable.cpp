@@ -0,0 +1,120 @@
+/*
+NMEA0183HandlerTable.cpp
+
+Copyright (c) 2015-2019 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#include "NMEA0183HandlerTable.h"
+
+//*****************************************************************************
+tNMEA0183HandlerTable::tNMEA0183HandlerTable(tEntry *_Entries, uint8_t _Bits)
+: Entries(_Entries), Mask((1<<_Bits)-1), Bits(_Bits) {
+  Clear();
+}
+
+//*****************************************************************************
+void tNMEA0183HandlerTable::Clear() {
+  for ( uint16_t i=0; i<=Mask; i++ ) Entries[i].Handler=0;
+  Count=0;
+}
+
+//*****************************************************************************
+// Multiplicative hash. Top bits of product are best mixed.
+uint16_t tNMEA0183HandlerTable::Hash(uint16_t SenderId, uint32_t CodeId) const {
+  uint32_t h=(CodeId ^ ((uint32_t)SenderId<<18) ^ SenderId)*2654435761UL;
+  return h>>(32-Bits);
+}
+
+//*****************************************************************************
+int16_t tNMEA0183HandlerTable::Find(uint16_t SenderId, uint32_t CodeId) const {
+  for ( uint16_t i=Hash(SenderId,CodeId); Entries[i].Handler!=0; i=(i+1) & Mask ) {
+    if ( Entries[i].CodeId==CodeId && Entries[i].SenderId==SenderId ) return i;
+  }
+
+  return -1;
+}
+
+//*****************************************************************************
+bool tNMEA0183HandlerTable::Add(uint16_t SenderId, uint32_t CodeId, tNMEA0183MsgHandlerFunc Handler, void *Context) {
+  if ( Handler==0 ) return Remove(SenderId,CodeId);
+
+  int16_t iEntry=Find(SenderId,CodeId);
+
+  if ( iEntry<0 ) {
+    if ( Count>=Mask+1-(Mask+1)/4 ) return false;
+    uint16_t i=Hash(SenderId,CodeId);
+    for ( ; Entries[i].Handler!=0; i=(i+1) & Mask );
+    iEntry=i;
+    Entries[iEntry].SenderId=SenderId;
+    Entries[iEntry].CodeId=CodeId;
+    Count++;
+  }
+  Entries[iEntry].Handler=Handler;
+  Entries[iEntry].Context=Context;
+
+  return true;
+}
+
+//*****************************************************************************
+// Linear probing without tombstones. Following entries of the probe chain will
+// be moved back to the hole, so that they can still be found.
+bool tNMEA0183HandlerTable::Remove(uint16_t SenderId, uint32_t CodeId) {
+  int16_t iEntry=Find(SenderId,CodeId);
+  if ( iEntry<0 ) return false;
+
+  uint16_t Hole=iEntry;
+  Entries[Hole].Handler=0;
+  Count--;
+
+  for ( uint16_t i=(Hole+1) & Mask; Entries[i].Handler!=0; i=(i+1) & Mask ) {
+    uint16_t Home=Hash(Entries[i].SenderId,Entries[i].CodeId);
+    // Entry can be moved, if its home is not cyclically between hole and entry.
+    if ( ((i-Home) & Mask) >= ((i-Hole) & Mask) ) {
+      Entries[Hole]=Entries[i];
+      Entries[i].Handler=0;
+      Hole=i;
+    }
+  }
+
+  return true;
+}
+
+//*****************************************************************************
+bool tNMEA0183HandlerTable::Call(uint16_t SenderId, uint32_t CodeId, const tNMEA0183MsgView &NMEA0183Msg) const {
+  int16_t iEntry=Find(SenderId,CodeId);
+  if ( iEntry<0 ) return false;
+
+  Entries[iEntry].Handler(NMEA0183Msg,Entries[iEntry].Context);
+  return true;
+}
+
+//*****************************************************************************
+bool tNMEA0183HandlerTable::Dispatch(const tNMEA0183MsgView &NMEA0183Msg) const {
+  if ( Count==0 ) return false;
+
+  uint16_t SenderId=NMEA0183Msg.SenderId();
+  uint32_t CodeId=NMEA0183Msg.MessageCodeId();
+
+  return ( Call(SenderId,CodeId,NMEA0183Msg) ||
+           Call(0,CodeId,NMEA0183Msg) ||
+           Call(SenderId,0,NMEA0183Msg) ||
+           Call(0,0,NMEA0183Msg) );
+}
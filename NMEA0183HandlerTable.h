@@ -0,0 +1,106 @@
+/*
+NMEA0183HandlerTable.h
+
+Copyright (c) 2015-2019 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+Message handler table keyed by sender and message code. Handlers are kept
+on fixed size open addressing hash table, so finding handler does not depend
+on count of handlers. Sender or message code can be wildcard. For a message
+only the most specific handler will be called:
+  1. handler for sender and message code
+  2. handler for message code from any sender
+  3. handler for sender with any message code
+  4. handler for any message
+*/
+
+#ifndef _tNMEA0183_HANDLER_TABLE_H_
+#define _tNMEA0183_HANDLER_TABLE_H_
+
+#include "NMEA0183MsgView.h"
+
+// Default table of tNMEA0183HandlerTableT has 2^NMEA0183_HANDLER_TABLE_BITS slots
+// (bits 2..15). Max 3/4 of them can be used.
+#ifndef NMEA0183_HANDLER_TABLE_BITS
+#if defined(__AVR__)
+#define NMEA0183_HANDLER_TABLE_BITS 3
+#else
+#define NMEA0183_HANDLER_TABLE_BITS 6
+#endif
+#endif
+
+typedef void (*tNMEA0183MsgHandlerFunc)(const tNMEA0183MsgView &NMEA0183Msg, void *Context);
+
+//------------------------------------------------------------------------------
+// Table on storage given by caller. Use tNMEA0183HandlerTableT to have storage
+// inside the table.
+class tNMEA0183HandlerTable
+{
+  public:
+    struct tEntry {
+      uint32_t CodeId;
+      uint16_t SenderId;
+      tNMEA0183MsgHandlerFunc Handler; // 0 for free slot
+      void *Context;
+    };
+
+  protected:
+    tEntry *Entries;
+    uint16_t Mask;  // Slot count-1
+    uint8_t Bits;
+    uint16_t Count;
+
+  protected:
+    uint16_t Hash(uint16_t SenderId, uint32_t CodeId) const;
+    int16_t Find(uint16_t SenderId, uint32_t CodeId) const;
+    bool Call(uint16_t SenderId, uint32_t CodeId, const tNMEA0183MsgView &NMEA0183Msg) const;
+
+  private:
+    // Copy would share storage.
+    tNMEA0183HandlerTable(const tNMEA0183HandlerTable &);
+    tNMEA0183HandlerTable &operator=(const tNMEA0183HandlerTable &);
+
+  public:
+    // Use _Entries with 2^_Bits slots (bits 2..15) as storage.
+    tNMEA0183HandlerTable(tEntry *_Entries, uint8_t _Bits);
+    // Add or replace handler for sender and message code id. Id 0 means any. Returns false, if table is full.
+    bool Add(uint16_t SenderId, uint32_t CodeId, tNMEA0183MsgHandlerFunc Handler, void *Context=0);
+    // Remove handler for sender and message code id. Returns false, if there was no handler.
+    bool Remove(uint16_t SenderId, uint32_t CodeId);
+    void Clear();
+    uint16_t HandlerCount() const { return Count; }
+    // Call the most specific handler for message. Returns false, if there was no handler.
+    bool Dispatch(const tNMEA0183MsgView &NMEA0183Msg) const;
+};
+
+//------------------------------------------------------------------------------
+// Table with 2^TableBits slots inside the object.
+template <uint8_t TableBits=NMEA0183_HANDLER_TABLE_BITS>
+class tNMEA0183HandlerTableT : public tNMEA0183HandlerTable
+{
+  static_assert(TableBits>=2 && TableBits<=15,"Invalid handler table size");
+
+  protected:
+    tEntry Storage[1<<TableBits];
+
+  public:
+    tNMEA0183HandlerTableT() : tNMEA0183HandlerTable(Storage,TableBits) {}
+};
+
+#endif
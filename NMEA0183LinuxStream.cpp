@@ -26,26 +26,24 @@ Inherited tNMEA0183Stream object for Linux
 
 #if defined(__linux__)||defined(__linux)||defined(linux)
 
-//#include <stdio.h>
-#include <iostream>
+#include <stdio.h>
 #include <unistd.h>
 #include <string.h>
 #include <fcntl.h>
+#include <termios.h>
 #include <sys/ioctl.h>
-#include <sys/select.h>
 #include "NMEA0183LinuxStream.h"
 
-
 //*****************************************************************************
-tNMEA0183LinuxStream::tNMEA0183LinuxStream(const char *_port) : port(-1) {
+tNMEA0183LinuxStream::tNMEA0183LinuxStream(const char *_port, unsigned long Baud)
+: port(-1), IsTty(false), ReadPos(0), ReadLen(0) {
   if ( _port!=0 ) {
-    port=open(_port, O_RDWR | O_NOCTTY | O_NDELAY);
+    port=open(_port, O_RDWR | O_NOCTTY | O_NONBLOCK);
   }
 
   if ( port!=-1 ) {
-//    cout << _port << " Opened" << endl;
-  } else {
-//    if ( _port!=0 ) cout << "Failed to open port " << _port << endl;
+    IsTty=( isatty(port)==1 );
+    if ( IsTty ) SetupTty(Baud);
   }
 }
 
@@ -56,43 +54,129 @@ tNMEA0183LinuxStream::~tNMEA0183LinuxStream() {
   }
 }
 
+//*****************************************************************************
+static speed_t BaudToSpeed(unsigned long Baud) {
+  switch ( Baud ) {
+    case 4800: return B4800;
+    case 9600: return B9600;
+    case 19200: return B19200;
+    case 38400: return B38400;
+    case 57600: return B57600;
+    case 115200: return B115200;
+    case 230400: return B230400;
+    case 460800: return B460800;
+    default: return B0;
+  }
+}
 
-/********************************************************************
-*	Other 'Bridge' functions and classes
-*
-*
-*
-**********************************************************************/
-int tNMEA0183LinuxStream:: read() {
-  if ( port!=-1 ) {
-    return -1;
-  } else {
-    // Serial stream bridge -- Returns first byte if incoming data, or -1 on no available data.
-    struct timeval tv = { 0L, 0L };
-    fd_set fds;
+//*****************************************************************************
+// Raw 8N1 without flow control. VMIN=0 and VTIME=0 makes read return immediately.
+bool tNMEA0183LinuxStream::SetupTty(unsigned long Baud) {
+  struct termios tio;
+
+  if ( tcgetattr(port,&tio)!=0 ) return false;
+
+  cfmakeraw(&tio);
+  tio.c_cflag|=CLOCAL | CREAD;
+  tio.c_cflag&=~CRTSCTS;
+  tio.c_cc[VMIN]=0;
+  tio.c_cc[VTIME]=0;
+  speed_t Speed=BaudToSpeed(Baud);
+  if ( Speed!=B0 ) {
+    cfsetispeed(&tio,Speed);
+    cfsetospeed(&tio,Speed);
+  }
+
+  return tcsetattr(port,TCSANOW,&tio)==0;
+}
 
-    FD_ZERO(&fds);
-    FD_SET(0, &fds);
-    if (select(1, &fds, NULL, NULL, &tv) < 0)                                   // Check fd=0 (stdin) to see if anything is there (timeout=0)
-        return -1;                                                              // Nothing is waiting for us.
+//*****************************************************************************
+size_t tNMEA0183LinuxStream::PendingIn() const {
+  int Pending=0;
+
+  if ( ioctl(InHandle(),FIONREAD,&Pending)!=0 || Pending<0 ) return 0;
+
+  return Pending;
+}
 
-   return (getc(stdin));                                                         // Something is there, go get one char of it.
+//*****************************************************************************
+// Port is non-blocking. stdin may block, so it will be read only as much as
+// there is available.
+size_t tNMEA0183LinuxStream::ReadHandle(uint8_t *buf, size_t len) {
+  if ( port==-1 ) {
+    size_t Pending=PendingIn();
+    if ( len>Pending ) len=Pending;
+    if ( len==0 ) return 0;
   }
+
+  ssize_t n=::read(InHandle(),buf,len);
+
+  return ( n>0 ? (size_t)n : 0 );
 }
 
+//*****************************************************************************
+bool tNMEA0183LinuxStream::FillReadBuf() {
+  if ( ReadPos<ReadLen ) return true;
 
+  ReadPos=0;
+  ReadLen=ReadHandle(ReadBuf,NMEA0183_LINUX_READ_BUF_LEN);
+
+  return ReadLen>0;
+}
 
 //*****************************************************************************
-size_t tNMEA0183LinuxStream:: write(const uint8_t* data, size_t size) {                // Serial Stream bridge -- Write data to stream.
-  if ( port!=-1 ) {
-    return ::write(port,data,size);
-  } else {
-    size_t i;
+int tNMEA0183LinuxStream::available() {
+  size_t Available=(ReadLen-ReadPos)+PendingIn();
+
+  return ( Available<0x7fff ? (int)Available : 0x7fff );
+}
+
+//*****************************************************************************
+int tNMEA0183LinuxStream::availableForWrite() {
+  if ( !IsTty ) return NMEA0183_LINUX_WRITE_BURST;
+
+  int Queued=0;
+  if ( ioctl(port,TIOCOUTQ,&Queued)!=0 ) return NMEA0183_LINUX_WRITE_BURST;
 
-    for (i=0; (i<size) && data[i];  i++)                                        // send chars to stdout for 'size' or until null is found.
-        putc(data[i],stdout);
+  return ( Queued<NMEA0183_LINUX_WRITE_BURST ? NMEA0183_LINUX_WRITE_BURST-Queued : 0 );
+}
+
+//*****************************************************************************
+int tNMEA0183LinuxStream::read() {
+  if ( !FillReadBuf() ) return -1;
+
+  return ReadBuf[ReadPos++];
+}
 
-    return(i);
+//*****************************************************************************
+// Buffered data will be returned first. Big requests will be read directly to buf.
+size_t tNMEA0183LinuxStream::read(uint8_t *buf, size_t len) {
+  size_t n=ReadLen-ReadPos;
+
+  if ( n>len ) n=len;
+  memcpy(buf,ReadBuf+ReadPos,n);
+  ReadPos+=n;
+  if ( n==len ) return n;
+
+  if ( len-n>=NMEA0183_LINUX_READ_BUF_LEN ) return n+ReadHandle(buf+n,len-n);
+
+  if ( !FillReadBuf() ) return n;
+  size_t m=ReadLen-ReadPos;
+  if ( m>len-n ) m=len-n;
+  memcpy(buf+n,ReadBuf+ReadPos,m);
+  ReadPos+=m;
+
+  return n+m;
+}
+
+//*****************************************************************************
+size_t tNMEA0183LinuxStream::write(const uint8_t* data, size_t size) {
+  if ( port!=-1 ) {
+    ssize_t Written=::write(port,data,size);
+    return ( Written>0 ? (size_t)Written : 0 );
+  } else {
+    // Use stdio, so that output keeps order with application prints.
+    return fwrite(data,1,size,stdout);
   }
 }
 
@@ -30,17 +30,48 @@ Inherited tNMEA0183Stream object for Linux
 #include "NMEA0183Stream.h"
 
 #if defined(__linux__)||defined(__linux)||defined(linux)
+
+// Size of the driver output queue assumed for availableForWrite.
+#ifndef NMEA0183_LINUX_WRITE_BURST
+#define NMEA0183_LINUX_WRITE_BURST 4096
+#endif
+
+// Size of the internal read buffer.
+#ifndef NMEA0183_LINUX_READ_BUF_LEN
+#define NMEA0183_LINUX_READ_BUF_LEN 1024
+#endif
+
 //-----------------------------------------------------------------------------
+// Stream for serial port or tty. If port has not been given or it could not be
+// opened, stream uses stdin and stdout. Port is opened non-blocking and tty will
+// be set to raw mode. Baud rate will be set, if it has been given.
 class tNMEA0183LinuxStream : public tNMEA0183Stream {
 protected:
   int port;
+  bool IsTty;
+  uint8_t ReadBuf[NMEA0183_LINUX_READ_BUF_LEN];
+  size_t ReadPos;
+  size_t ReadLen;
+
+  int InHandle() const { return ( port!=-1 ? port : 0 ); }
+  bool SetupTty(unsigned long Baud);
+  // Bytes, which can be read without blocking.
+  size_t PendingIn() const;
+  // Non-blocking read. Returns count of bytes read.
+  size_t ReadHandle(uint8_t *buf, size_t len);
+  bool FillReadBuf();
 public:
-    tNMEA0183LinuxStream(const char *_port=0);
+    tNMEA0183LinuxStream(const char *_port=0, unsigned long Baud=0);
     virtual ~tNMEA0183LinuxStream();
+    // File descriptor for event waiting. stdin is used, if port could not be opened.
+    int Handle() const { return InHandle(); }
+    int available();
+    // Driver output queue free space. Non tty handles just accept bursts.
+    int availableForWrite();
     int read();
+    size_t read(uint8_t *buf, size_t len);
     size_t write(const uint8_t* data, size_t size);
 };
 #endif
 
 #endif /* _NMEA0183_LINUX_STREAM_H_ */
-
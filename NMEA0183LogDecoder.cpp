@@ -0,0 +1,203 @@
+/*
+NMEA0183LogDecoder.cpp
+
+Copyright (c) 2015-2019 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#if defined(__linux__)||defined(__linux)||defined(linux)
+
+#include <string.h>
+#include <cstddef>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "NMEA0183LogDecoder.h"
+#include "NMEA0183Scan.h"
+
+//*****************************************************************************
+tNMEA0183LogDecoder::tNMEA0183LogDecoder(uint8_t Threads, size_t _ChunkSize)
+: ChunkSize(_ChunkSize>0 ? _ChunkSize : NMEA0183_LOG_CHUNK_SIZE), MessageCountValue(0), ErrorCountValue(0),
+  Data(0), Len(0), ChunkCount(0), NextChunk(0), DecodeFunc(0), ResultSize(0), Context(0), Slots(0), SlotCount(0) {
+  if ( Threads==0 ) {
+    long Online=sysconf(_SC_NPROCESSORS_ONLN);
+    Threads=( Online<1 ? 1 : Online>NMEA0183_LOG_DECODER_MAX_THREADS ? NMEA0183_LOG_DECODER_MAX_THREADS : Online );
+  }
+  if ( Threads>NMEA0183_LOG_DECODER_MAX_THREADS ) Threads=NMEA0183_LOG_DECODER_MAX_THREADS;
+  ThreadCount=Threads;
+  pthread_mutex_init(&Lock,0);
+  pthread_cond_init(&Changed,0);
+}
+
+//*****************************************************************************
+tNMEA0183LogDecoder::~tNMEA0183LogDecoder() {
+  pthread_cond_destroy(&Changed);
+  pthread_mutex_destroy(&Lock);
+}
+
+//*****************************************************************************
+// Message is framed from start character to two characters after '*' as on
+// tNMEA0183. New start character before '*' starts new message.
+void tNMEA0183LogDecoder::DecodeChunk(size_t Chunk, tSlot &Slot) {
+  const char *DataEnd=Data+Len;
+  const char *p=Data+Chunk*ChunkSize;
+  const char *End=( Len-Chunk*ChunkSize>ChunkSize ? p+ChunkSize : DataEnd );
+  tNMEA0183MsgView NMEA0183Msg;
+
+  memset(Slot.Result,0,ResultSize);
+  Slot.Messages=0;
+  Slot.Errors=0;
+
+  while ( p<End && (p=NMEA0183FindFirst(p,End,NMEA0183Scan_Start))!=0 ) {
+    const char *q=NMEA0183FindFirst(p+1,DataEnd,NMEA0183Scan_Start | NMEA0183Scan_CheckSum | NMEA0183Scan_LineEnd);
+    if ( q==0 || *q!='*' || DataEnd-q<3 ) {
+      Slot.Errors++;
+      if ( q==0 ) break;
+      p=q;
+      continue;
+    }
+    q+=3;
+    if ( NMEA0183Msg.SetMessage(p,q-p) ) {
+      Slot.Messages++;
+      DecodeFunc(NMEA0183Msg,Slot.Result,Context);
+    } else {
+      Slot.Errors++;
+    }
+    p=q;
+  }
+}
+
+//*****************************************************************************
+void *tNMEA0183LogDecoder::ThreadMain(void *Decoder) {
+  ((tNMEA0183LogDecoder *)Decoder)->WorkLoop();
+  return 0;
+}
+
+//*****************************************************************************
+// Threads take next chunk from shared counter, so fast threads just take more
+// chunks. Slot of chunk is free, when chunk SlotCount before has been merged.
+void tNMEA0183LogDecoder::WorkLoop() {
+  for ( ;; ) {
+    size_t Chunk=NextChunk.fetch_add(1);
+    if ( Chunk>=ChunkCount ) return;
+
+    tSlot &Slot=Slots[Chunk%SlotCount];
+    pthread_mutex_lock(&Lock);
+    while ( Slot.Chunk!=Chunk ) pthread_cond_wait(&Changed,&Lock);
+    pthread_mutex_unlock(&Lock);
+
+    DecodeChunk(Chunk,Slot);
+
+    pthread_mutex_lock(&Lock);
+    Slot.Done=true;
+    pthread_cond_broadcast(&Changed);
+    pthread_mutex_unlock(&Lock);
+  }
+}
+
+//*****************************************************************************
+bool tNMEA0183LogDecoder::Decode(const char *_Data, size_t _Len, tDecodeFunc Decode, tMergeFunc Merge, size_t _ResultSize, void *_Context) {
+  MessageCountValue=0;
+  ErrorCountValue=0;
+  if ( Decode==0 ) return false;
+  if ( _Data==0 || _Len==0 ) return true;
+
+  Data=_Data;
+  Len=_Len;
+  ChunkCount=(Len+ChunkSize-1)/ChunkSize;
+  NextChunk=0;
+  DecodeFunc=Decode;
+  ResultSize=_ResultSize;
+  Context=_Context;
+  SlotCount=2*(size_t)ThreadCount;
+  if ( SlotCount>ChunkCount ) SlotCount=ChunkCount;
+  Slots=new tSlot[SlotCount];
+  // Keep every result aligned as new gives the first one.
+  const size_t Align=alignof(std::max_align_t);
+  size_t Stride=(ResultSize+Align-1)/Align*Align;
+  char *Results=new char[SlotCount*Stride+1];
+  for ( size_t i=0; i<SlotCount; i++ ) {
+    Slots[i].Chunk=i;
+    Slots[i].Done=false;
+    Slots[i].Result=Results+i*Stride;
+  }
+
+  pthread_t Threads[NMEA0183_LOG_DECODER_MAX_THREADS];
+  uint8_t Started=0;
+  if ( ThreadCount>1 && ChunkCount>1 ) {
+    for ( ; Started<ThreadCount && Started<ChunkCount; Started++ ) {
+      if ( pthread_create(&Threads[Started],0,ThreadMain,this)!=0 ) break;
+    }
+  }
+
+  // Merge in order. Without threads chunks are decoded here.
+  for ( size_t Chunk=0; Chunk<ChunkCount; Chunk++ ) {
+    tSlot &Slot=Slots[Chunk%SlotCount];
+    if ( Started==0 ) {
+      DecodeChunk(Chunk,Slot);
+    } else {
+      pthread_mutex_lock(&Lock);
+      while ( !Slot.Done ) pthread_cond_wait(&Changed,&Lock);
+      pthread_mutex_unlock(&Lock);
+    }
+
+    if ( Merge!=0 ) Merge(Slot.Result,Context);
+    MessageCountValue+=Slot.Messages;
+    ErrorCountValue+=Slot.Errors;
+
+    pthread_mutex_lock(&Lock);
+    Slot.Chunk=Chunk+SlotCount;
+    Slot.Done=false;
+    pthread_cond_broadcast(&Changed);
+    pthread_mutex_unlock(&Lock);
+  }
+
+  for ( uint8_t i=0; i<Started; i++ ) pthread_join(Threads[i],0);
+  delete[] Results;
+  delete[] Slots;
+  Slots=0;
+  Data=0;
+
+  return true;
+}
+
+//*****************************************************************************
+bool tNMEA0183LogDecoder::DecodeFile(const char *FileName, tDecodeFunc Decode, tMergeFunc Merge, size_t _ResultSize, void *_Context) {
+  struct stat st;
+
+  if ( FileName==0 ) return false;
+  int fd=open(FileName,O_RDONLY | O_CLOEXEC);
+  if ( fd==-1 ) return false;
+  if ( fstat(fd,&st)!=0 ) { close(fd); return false; }
+  if ( st.st_size==0 ) { close(fd); return this->Decode(0,0,Decode,Merge,_ResultSize,_Context); }
+
+  void *Map=mmap(0,st.st_size,PROT_READ,MAP_PRIVATE,fd,0);
+  close(fd);
+  if ( Map==MAP_FAILED ) return false;
+  madvise(Map,st.st_size,MADV_WILLNEED);
+
+  bool Result=this->Decode((const char *)Map,st.st_size,Decode,Merge,_ResultSize,_Context);
+  munmap(Map,st.st_size);
+
+  return Result;
+}
+
+#endif
@@ -0,0 +1,120 @@
+/*
+NMEA0183LogDecoder.h
+
+Copyright (c) 2015-2019 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+Parallel decoder for large NMEA0183 log files on Linux. Log will be split to
+chunks, which are decoded on thread pool. Each chunk starts from the first
+'$' or '!' after its boundary and contains messages starting before next
+boundary, so every message belongs to exactly one chunk.
+
+Decode function will be called on pool thread for each valid message of chunk
+and it should collect wanted data to chunk result, e.g. with parsers on
+NMEA0183Messages.h. Merge function will be called on the calling thread for
+chunk results in file order. Result is zero filled before chunk is decoded.
+
+  struct tResult { uint32_t RMCCount; ... };
+  void Decode(const tNMEA0183MsgView &Msg, void *Result, void *Context) { ... }
+  void Merge(void *Result, void *Context) { ... }
+
+  tNMEA0183LogDecoder Decoder;
+  Decoder.DecodeFile("voyage.log",Decode,Merge,sizeof(tResult),&Track);
+*/
+
+#ifndef _tNMEA0183_LOG_DECODER_H_
+#define _tNMEA0183_LOG_DECODER_H_
+
+#if defined(__linux__)||defined(__linux)||defined(linux)
+
+#include <stdint.h>
+#include <stddef.h>
+#include <pthread.h>
+#include <atomic>
+#include "NMEA0183MsgView.h"
+
+#ifndef NMEA0183_LOG_DECODER_MAX_THREADS
+#define NMEA0183_LOG_DECODER_MAX_THREADS 64
+#endif
+
+#ifndef NMEA0183_LOG_CHUNK_SIZE
+#define NMEA0183_LOG_CHUNK_SIZE (4UL*1024*1024)
+#endif
+
+//------------------------------------------------------------------------------
+class tNMEA0183LogDecoder
+{
+  public:
+    // Called on pool thread for every valid message. Result belongs to message chunk.
+    typedef void (*tDecodeFunc)(const tNMEA0183MsgView &NMEA0183Msg, void *Result, void *Context);
+    // Called on decoding thread for chunk results in file order.
+    typedef void (*tMergeFunc)(void *Result, void *Context);
+
+  protected:
+    // Chunk results are kept on window of slots. Chunk uses slot Chunk%SlotCount
+    // and waits, until previous chunk on slot has been merged.
+    struct tSlot {
+      size_t Chunk;   // Chunk, which may use or is using slot
+      bool Done;      // Chunk has been decoded and waits merge
+      uint32_t Messages;
+      uint32_t Errors;
+      char *Result;
+    };
+
+    uint8_t ThreadCount;
+    size_t ChunkSize;
+    uint64_t MessageCountValue;
+    uint64_t ErrorCountValue;
+
+    // State of running decode
+    const char *Data;
+    size_t Len;
+    size_t ChunkCount;
+    std::atomic<size_t> NextChunk;
+    tDecodeFunc DecodeFunc;
+    size_t ResultSize;
+    void *Context;
+    tSlot *Slots;
+    size_t SlotCount;
+    pthread_mutex_t Lock;
+    pthread_cond_t Changed;
+
+  protected:
+    static void *ThreadMain(void *Decoder);
+    void WorkLoop();
+    // Decode messages starting on chunk to slot result.
+    void DecodeChunk(size_t Chunk, tSlot &Slot);
+
+  public:
+    // Threads 0 means count of online processors.
+    tNMEA0183LogDecoder(uint8_t Threads=0, size_t _ChunkSize=NMEA0183_LOG_CHUNK_SIZE);
+    ~tNMEA0183LogDecoder();
+    // Decode log in memory. Returns false, if threads could not be started.
+    bool Decode(const char *_Data, size_t _Len, tDecodeFunc Decode, tMergeFunc Merge, size_t _ResultSize, void *_Context=0);
+    // Map log file to memory and decode it.
+    bool DecodeFile(const char *FileName, tDecodeFunc Decode, tMergeFunc Merge, size_t _ResultSize, void *_Context=0);
+    uint8_t GetThreadCount() const { return ThreadCount; }
+    // Statistics of last decode. Errors are framed messages, which were invalid.
+    uint64_t MessageCount() const { return MessageCountValue; }
+    uint64_t ErrorCount() const { return ErrorCountValue; }
+};
+
+#endif
+
+#endif
@@ -23,6 +23,7 @@ OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 
 #include "NMEA0183Messages.h"
+#include "NMEA0183FieldParser.h"
 #include <math.h>
 #include <string.h>
 #include <stdlib.h>
@@ -61,14 +62,9 @@ void NMEA0183AddChecksum(char* msg) {
 
 //*****************************************************************************
 double NMEA0183GetDouble(const char *data) {
-  double val=NMEA0183DoubleNA;
-  if ( data==0 ) return val;
+  double val;
 
-  for ( ;*data==' ';data++); // Pass spaces
-
-  if ( *data!=0 ) {
-    val=atof(data);
-  }
+  if ( data==0 || !NMEA0183FieldToDouble(data,strlen(data),val) ) return NMEA0183DoubleNA;
 
   return val;
 }
@@ -83,59 +79,78 @@ double NMEA0183GetDouble(const char *data, const double &multiplier) {
 }
 
 //*****************************************************************************
-double LatLonToDouble(const char *data, const char sign) {
-  double val=atof(data);
-  double deg=floor(val/100);
+static double NMEA0183GetDouble(const tNMEA0183MsgView &NMEA0183Msg, uint8_t index, const double &multiplier) {
+  double val;
 
-  val=deg+(val-deg*100.0)/60.0;
-  if ( sign=='S' || sign=='W' ) val=-val;
+  if ( !NMEA0183FieldToDouble(NMEA0183Msg.Field(index),NMEA0183Msg.FieldLen(index),val) ) return NMEA0183DoubleNA;
 
-  return val;
+  return val*multiplier;
+}
+
+//*****************************************************************************
+// Field helpers below return 0 for empty field as atof did before.
+static double FieldToDouble(const tNMEA0183MsgView &NMEA0183Msg, uint8_t index, const double &multiplier=1.0) {
+  double val;
+
+  return ( NMEA0183FieldToDouble(NMEA0183Msg.Field(index),NMEA0183Msg.FieldLen(index),val)?val*multiplier:0 );
+}
+
+//*****************************************************************************
+static int FieldToInt(const tNMEA0183MsgView &NMEA0183Msg, uint8_t index) {
+  int32_t val;
+
+  return ( NMEA0183FieldToInt32(NMEA0183Msg.Field(index),NMEA0183Msg.FieldLen(index),val)?val:0 );
+}
+
+//*****************************************************************************
+// Latitude or longitude on field index and sign on next field.
+static double FieldToLatLon(const tNMEA0183MsgView &NMEA0183Msg, uint8_t index) {
+  double val;
+
+  return ( NMEA0183FieldToLatLon(NMEA0183Msg.Field(index),NMEA0183Msg.FieldLen(index),NMEA0183Msg.FieldChar(index+1),val)?val:0 );
+}
+
+//*****************************************************************************
+static double FieldToSeconds(const tNMEA0183MsgView &NMEA0183Msg, uint8_t index) {
+  double val;
+
+  return ( NMEA0183FieldToSeconds(NMEA0183Msg.Field(index),NMEA0183Msg.FieldLen(index),val)?val:0 );
+}
+
+//*****************************************************************************
+double LatLonToDouble(const char *data, const char sign) {
+  double val;
+
+  return ( data!=0 && NMEA0183FieldToLatLon(data,strlen(data),sign,val)?val:0 );
 }
 
 //*****************************************************************************
 double NMEA0183GPTimeToSeconds(const char *data) {
-  double val=atof(data);
-  double hh=floor(val/10000);
-  double mm=floor((val-hh*10000)/100);
+  double val;
 
-  val=hh*3600+mm*60+(val-hh*10000.0-mm*100);
+  return ( data!=0 && NMEA0183FieldToSeconds(data,strlen(data),val)?val:0 );
+}
 
-  return val;
+//*****************************************************************************
+static inline int TwoDigits(const char *data) {
+  return (data[0]-'0')*10+(data[1]-'0');
 }
 
 //*****************************************************************************
 time_t NMEA0183GPSDateTimetotime_t(const char *dateStr, const char *timeStr) {
-  tmElements_t TimeElements;
-  char StrCvt[3]="00";
-
-    if (timeStr!=0 && strlen(timeStr)>=6) {
-      StrCvt[0]=timeStr[0]; StrCvt[1]=timeStr[1];
-      tNMEA0183Msg::SetHour(TimeElements,atoi(StrCvt));
-      StrCvt[0]=timeStr[2]; StrCvt[1]=timeStr[3];
-      tNMEA0183Msg::SetMin(TimeElements,atoi(StrCvt));
-      StrCvt[0]=timeStr[4]; StrCvt[1]=timeStr[5];
-      tNMEA0183Msg::SetSec(TimeElements,atoi(StrCvt));
-    } else {
-      tNMEA0183Msg::SetHour(TimeElements,0);
-      tNMEA0183Msg::SetMin(TimeElements,0);
-      tNMEA0183Msg::SetSec(TimeElements,0);
-    }
+  unsigned long Seconds=0;
+  long Days=0;
 
-    if (dateStr!=0 && strlen(dateStr)==6) {
-      StrCvt[0]=dateStr[0]; StrCvt[1]=dateStr[1];
-      tNMEA0183Msg::SetDay(TimeElements,atoi(StrCvt));
-      StrCvt[0]=dateStr[2]; StrCvt[1]=dateStr[3];
-      tNMEA0183Msg::SetMonth(TimeElements,atoi(StrCvt));
-      StrCvt[0]=dateStr[4]; StrCvt[1]=dateStr[5];
-      tNMEA0183Msg::SetYear(TimeElements,2000+atoi(StrCvt));
-    } else {
-      tNMEA0183Msg::SetYear(TimeElements,0);
-      tNMEA0183Msg::SetMonth(TimeElements,0);
-      tNMEA0183Msg::SetDay(TimeElements,0);
-    }
+  if (timeStr!=0 && strlen(timeStr)>=6) {
+    Seconds=TwoDigits(timeStr)*3600UL+TwoDigits(timeStr+2)*60UL+TwoDigits(timeStr+4);
+  }
+
+  if (dateStr!=0 && strlen(dateStr)==6) {
+    Days=NMEA0183DaysFromCivil(2000+TwoDigits(dateStr+4),TwoDigits(dateStr+2),TwoDigits(dateStr));
+    Days-=(long)NMEA0183_TIME_T_DAYS_TO_1970;
+  }
 
-    return tNMEA0183Msg::makeTime(TimeElements);
+  return (time_t)Days*86400L+Seconds;
 }
 
 //*****************************************************************************
@@ -193,24 +208,24 @@ bool NMEA0183SetDPT(tNMEA0183Msg &NMEA0183Msg, double DepthBelowTransducer, doub
 
 //*****************************************************************************
 // $GPGGA,182435.00,6023.20859,N,02219.99442,E,2,10,0.9,4.0,M,20.6,M,5.0,0120*4D
-bool NMEA0183ParseGGA_nc(const tNMEA0183Msg &NMEA0183Msg, double &GPSTime, double &Latitude, double &Longitude,
+bool NMEA0183ParseGGA_nc(const tNMEA0183MsgView &NMEA0183Msg, double &GPSTime, double &Latitude, double &Longitude,
                       int &GPSQualityIndicator, int &SatelliteCount, double &HDOP, double &Altitude, double &GeoidalSeparation,
                       double &DGPSAge, int &DGPSReferenceStationID) {
   bool result=( NMEA0183Msg.FieldCount()>=14 );
 
   if ( result ) {
-    GPSTime=NMEA0183GPTimeToSeconds(NMEA0183Msg.Field(0));
-    Latitude=LatLonToDouble(NMEA0183Msg.Field(1),NMEA0183Msg.Field(2)[0]);
-    Longitude=LatLonToDouble(NMEA0183Msg.Field(3),NMEA0183Msg.Field(4)[0]);
-    GPSQualityIndicator=atoi(NMEA0183Msg.Field(5));
-    SatelliteCount=atoi(NMEA0183Msg.Field(6));
-    HDOP=atof(NMEA0183Msg.Field(7));
-    Altitude=atof(NMEA0183Msg.Field(8));
+    GPSTime=FieldToSeconds(NMEA0183Msg,0);
+    Latitude=FieldToLatLon(NMEA0183Msg,1);
+    Longitude=FieldToLatLon(NMEA0183Msg,3);
+    GPSQualityIndicator=FieldToInt(NMEA0183Msg,5);
+    SatelliteCount=FieldToInt(NMEA0183Msg,6);
+    HDOP=FieldToDouble(NMEA0183Msg,7);
+    Altitude=FieldToDouble(NMEA0183Msg,8);
     // Check units of antenna altitude NMEA0183Msg.Field(9)
-    GeoidalSeparation=atof(NMEA0183Msg.Field(10));
+    GeoidalSeparation=FieldToDouble(NMEA0183Msg,10);
     // Check units of GeoidalSeparation NMEA0183Msg.Field(11)
-    DGPSAge=atof(NMEA0183Msg.Field(12));
-    DGPSReferenceStationID=atoi(NMEA0183Msg.Field(13));
+    DGPSAge=FieldToDouble(NMEA0183Msg,12);
+    DGPSReferenceStationID=FieldToInt(NMEA0183Msg,13);
   }
 
   return result;
@@ -239,15 +254,15 @@ bool NMEA0183SetGGA(tNMEA0183Msg &NMEA0183Msg, double GPSTime, double Latitude,
 //*****************************************************************************
 //$GPGLL,5246.241,N,00506.648,E,155957,A*2B
 //$GPGLL,,,,,155648,*5B
-bool NMEA0183ParseGLL_nc(const tNMEA0183Msg &NMEA0183Msg, tGLL &GLL) {
+bool NMEA0183ParseGLL_nc(const tNMEA0183MsgView &NMEA0183Msg, tGLL &GLL) {
 
   bool result=( NMEA0183Msg.FieldCount()>= 6);
 
   if ( result ) {
-    GLL.latitude=LatLonToDouble(NMEA0183Msg.Field(0),NMEA0183Msg.Field(1)[0]);
-    GLL.longitude=LatLonToDouble(NMEA0183Msg.Field(2),NMEA0183Msg.Field(3)[0]);
-    GLL.GPSTime=NMEA0183GPTimeToSeconds(NMEA0183Msg.Field(4));
-    GLL.status=NMEA0183Msg.Field(5)[0];
+    GLL.latitude=FieldToLatLon(NMEA0183Msg,0);
+    GLL.longitude=FieldToLatLon(NMEA0183Msg,2);
+    GLL.GPSTime=FieldToSeconds(NMEA0183Msg,4);
+    GLL.status=NMEA0183Msg.FieldChar(5);
   }
   return result;
 }
@@ -272,27 +287,25 @@ bool NMEA0183SetGLL(tNMEA0183Msg &NMEA0183Msg, double GPSTime, double Latitude,
 
 //*****************************************************************************
 //$GPRMB,A,0.15,R,WOUBRG,WETERB,5213.400,N,00438.400,E,009.4,180.2,,V*07
-bool NMEA0183ParseRMB_nc(const tNMEA0183Msg &NMEA0183Msg, tRMB &RMB) {
+bool NMEA0183ParseRMB_nc(const tNMEA0183MsgView &NMEA0183Msg, tRMB &RMB) {
 
   bool result=( NMEA0183Msg.FieldCount()>=13 );
 
   if ( result ) {
 
   //Ignore Field(0). Assume status is OK.
-	RMB.status=NMEA0183Msg.Field(0)[0];
-  RMB.xte=atof(NMEA0183Msg.Field(1))*nmTom;
+	RMB.status=NMEA0183Msg.FieldChar(0);
+  RMB.xte=FieldToDouble(NMEA0183Msg,1,nmTom);
 	//Left is negative in NMEA2000. Right is positive.
-	if (NMEA0183Msg.Field(2)[0]=='R') RMB.xte=-RMB.xte;
-    strncpy(RMB.originID,NMEA0183Msg.Field(3),sizeof(RMB.originID)/sizeof(char));
-    RMB.originID[sizeof(RMB.originID)/sizeof(char)-1]='\0';
-    strncpy(RMB.destID,NMEA0183Msg.Field(4),sizeof(RMB.destID)/sizeof(char));
-    RMB.destID[sizeof(RMB.destID)/sizeof(char)-1]='\0';
-    RMB.latitude=LatLonToDouble(NMEA0183Msg.Field(5),NMEA0183Msg.Field(6)[0]);
-    RMB.longitude=LatLonToDouble(NMEA0183Msg.Field(7),NMEA0183Msg.Field(8)[0]);
-    RMB.dtw=atof(NMEA0183Msg.Field(9))*nmTom;
-    RMB.btw=atof(NMEA0183Msg.Field(10))*degToRad;
-    RMB.vmg=atof(NMEA0183Msg.Field(11))*knToms;
-	  RMB.arrivalAlarm=NMEA0183Msg.Field(12)[0];
+	if (NMEA0183Msg.FieldChar(2)=='R') RMB.xte=-RMB.xte;
+    NMEA0183Msg.CopyField(3,RMB.originID,sizeof(RMB.originID)/sizeof(char));
+    NMEA0183Msg.CopyField(4,RMB.destID,sizeof(RMB.destID)/sizeof(char));
+    RMB.latitude=FieldToLatLon(NMEA0183Msg,5);
+    RMB.longitude=FieldToLatLon(NMEA0183Msg,7);
+    RMB.dtw=FieldToDouble(NMEA0183Msg,9,nmTom);
+    RMB.btw=FieldToDouble(NMEA0183Msg,10,degToRad);
+    RMB.vmg=FieldToDouble(NMEA0183Msg,11,knToms);
+	  RMB.arrivalAlarm=NMEA0183Msg.FieldChar(12);
   }
 
   return result;
@@ -301,23 +314,25 @@ bool NMEA0183ParseRMB_nc(const tNMEA0183Msg &NMEA0183Msg, tRMB &RMB) {
 
 //*****************************************************************************
 // $GPRMC,092348.00,A,6035.04228,N,02115.15472,E,0.01,272.61,060815,7.2,E,D*34
-bool NMEA0183ParseRMC_nc(const tNMEA0183Msg &NMEA0183Msg, double &GPSTime, double &Latitude, double &Longitude,
+bool NMEA0183ParseRMC_nc(const tNMEA0183MsgView &NMEA0183Msg, double &GPSTime, double &Latitude, double &Longitude,
                       double &TrueCOG, double &SOG, unsigned long &DaysSince1970, double &Variation, time_t *DateTime) {
   bool result=( NMEA0183Msg.FieldCount()>=11 );
 
   if ( result ) {
     time_t lDT;
+    char DateStr[7];
 
-    GPSTime=NMEA0183GPTimeToSeconds(NMEA0183Msg.Field(0));
-    Latitude=LatLonToDouble(NMEA0183Msg.Field(2),NMEA0183Msg.Field(3)[0]);
-    Longitude=LatLonToDouble(NMEA0183Msg.Field(4),NMEA0183Msg.Field(5)[0]);
-    SOG=atof(NMEA0183Msg.Field(6))*knToms;
-    TrueCOG=atof(NMEA0183Msg.Field(7))*degToRad;
+    GPSTime=FieldToSeconds(NMEA0183Msg,0);
+    Latitude=FieldToLatLon(NMEA0183Msg,2);
+    Longitude=FieldToLatLon(NMEA0183Msg,4);
+    SOG=FieldToDouble(NMEA0183Msg,6,knToms);
+    TrueCOG=FieldToDouble(NMEA0183Msg,7,degToRad);
 
-    lDT=NMEA0183GPSDateTimetotime_t(NMEA0183Msg.Field(8),0)+floor(GPSTime);
+    NMEA0183Msg.CopyField(8,DateStr,sizeof(DateStr));
+    lDT=NMEA0183GPSDateTimetotime_t(DateStr,0)+floor(GPSTime);
     DaysSince1970=tNMEA0183Msg::elapsedDaysSince1970(lDT);
     if (DateTime!=0) *DateTime=lDT;
-    Variation=atof(NMEA0183Msg.Field(9))*degToRad; if (NMEA0183Msg.Field(10)[0]=='W') Variation=-Variation;
+    Variation=FieldToDouble(NMEA0183Msg,9,degToRad); if (NMEA0183Msg.FieldChar(10)=='W') Variation=-Variation;
   }
 
   return result;
@@ -362,16 +377,16 @@ bool NMEA0183SetRMC(tNMEA0183Msg &NMEA0183Msg, double GPSTime, double Latitude,
 
 //*****************************************************************************
 // $GPVTG,89.34,T,81.84,M,0.00,N,0.01,K*24
-bool NMEA0183ParseVTG_nc(const tNMEA0183Msg &NMEA0183Msg, double &TrueCOG, double &MagneticCOG, double &SOG) {
+bool NMEA0183ParseVTG_nc(const tNMEA0183MsgView &NMEA0183Msg, double &TrueCOG, double &MagneticCOG, double &SOG) {
   bool result=( NMEA0183Msg.FieldCount()>=8 );
 
   if ( result ) {
-    TrueCOG=atof(NMEA0183Msg.Field(0))*degToRad;
-    MagneticCOG=atof(NMEA0183Msg.Field(2))*degToRad;
-    if (NMEA0183Msg.Field(6)[0]!=0) {  // km/h is valid
-      SOG=atof(NMEA0183Msg.Field(6))*kmhToms;
+    TrueCOG=FieldToDouble(NMEA0183Msg,0,degToRad);
+    MagneticCOG=FieldToDouble(NMEA0183Msg,2,degToRad);
+    if (NMEA0183Msg.FieldLen(6)!=0) {  // km/h is valid
+      SOG=FieldToDouble(NMEA0183Msg,6,kmhToms);
     } else {
-      SOG=atof(NMEA0183Msg.Field(4))*knToms;
+      SOG=FieldToDouble(NMEA0183Msg,4,knToms);
     }
   }
 
@@ -397,16 +412,16 @@ bool NMEA0183SetVTG(tNMEA0183Msg &NMEA0183Msg, double TrueCOG, double MagneticCO
 
 //*****************************************************************************
 // $VWVHW,x.x,T,x.x,M,x.x,N,x.x,K*24
-bool NMEA0183ParseVHW_nc(const tNMEA0183Msg &NMEA0183Msg, double &TrueHeading, double &MagneticHeading, double &SOW) {
+bool NMEA0183ParseVHW_nc(const tNMEA0183MsgView &NMEA0183Msg, double &TrueHeading, double &MagneticHeading, double &SOW) {
   bool result=( NMEA0183Msg.FieldCount()>=8 );
 
   if ( result ) {
-    TrueHeading=NMEA0183GetDouble(NMEA0183Msg.Field(0),degToRad);
-    MagneticHeading=NMEA0183GetDouble(NMEA0183Msg.Field(2),degToRad);
-    if (NMEA0183Msg.Field(6)[0]!=0) {  // km/h is valid
-      SOW=NMEA0183GetDouble(NMEA0183Msg.Field(6),kmhToms);
+    TrueHeading=NMEA0183GetDouble(NMEA0183Msg,0,degToRad);
+    MagneticHeading=NMEA0183GetDouble(NMEA0183Msg,2,degToRad);
+    if (NMEA0183Msg.FieldLen(6)!=0) {  // km/h is valid
+      SOW=NMEA0183GetDouble(NMEA0183Msg,6,kmhToms);
     } else {
-      SOW=NMEA0183GetDouble(NMEA0183Msg.Field(4),knToms);
+      SOW=NMEA0183GetDouble(NMEA0183Msg,4,knToms);
     }
   }
 
@@ -477,10 +492,10 @@ bool NMEA0183BuildVTG(char* msg, const char Src[], double TrueCOG, double Magnet
 
 //*****************************************************************************
 // $HEROT,4.71,A*1B
-bool NMEA0183ParseROT_nc(const tNMEA0183Msg &NMEA0183Msg,double &RateOfTurn) {
+bool NMEA0183ParseROT_nc(const tNMEA0183MsgView &NMEA0183Msg,double &RateOfTurn) {
   bool result=( NMEA0183Msg.FieldCount()>=2 );
   if ( result ) {
-    RateOfTurn=atof(NMEA0183Msg.Field(0))*degToRad;
+    RateOfTurn=FieldToDouble(NMEA0183Msg,0,degToRad);
   }
 
   return result;
@@ -494,10 +509,10 @@ bool NMEA0183SetROT(tNMEA0183Msg &NMEA0183Msg, double RateOfTurn, const char *Sr
 
 //*****************************************************************************
 // $HEHDT,244.71,T*1B
-bool NMEA0183ParseHDT_nc(const tNMEA0183Msg &NMEA0183Msg,double &TrueHeading) {
+bool NMEA0183ParseHDT_nc(const tNMEA0183MsgView &NMEA0183Msg,double &TrueHeading) {
   bool result=( NMEA0183Msg.FieldCount()>=2 );
   if ( result ) {
-    TrueHeading=atof(NMEA0183Msg.Field(0))*degToRad;
+    TrueHeading=FieldToDouble(NMEA0183Msg,0,degToRad);
   }
 
   return result;
@@ -512,10 +527,10 @@ bool NMEA0183SetHDT(tNMEA0183Msg &NMEA0183Msg, double Heading, const char *Src)
 
 //*****************************************************************************
 // $HEHDM,244.71,M*1B
-bool NMEA0183ParseHDM_nc(const tNMEA0183Msg &NMEA0183Msg,double &MagneticHeading) {
+bool NMEA0183ParseHDM_nc(const tNMEA0183MsgView &NMEA0183Msg,double &MagneticHeading) {
   bool result=( NMEA0183Msg.FieldCount()>=2 );
   if ( result ) {
-    MagneticHeading=atof(NMEA0183Msg.Field(0))*degToRad;
+    MagneticHeading=FieldToDouble(NMEA0183Msg,0,degToRad);
   }
 
   return result;
@@ -568,7 +583,7 @@ bool NMEA0183SetHDG(tNMEA0183Msg &NMEA0183Msg, double Heading, double Deviation,
 // Radio Channel Code (B): A/B or 1/2
 // Payload - 6bit encoded
 // Fillbits (0)
-bool NMEA0183ParseVDM_nc(const tNMEA0183Msg &NMEA0183Msg,
+bool NMEA0183ParseVDM_nc(const tNMEA0183MsgView &NMEA0183Msg,
 			uint8_t &pkgCnt, uint8_t &pkgNmb,
 			unsigned int &seqMessageId, char &channel,
 			unsigned int &length, char *bitstream,
@@ -582,11 +597,11 @@ bool NMEA0183ParseVDM_nc(const tNMEA0183Msg &NMEA0183Msg,
       return false;
     length = payloadLen;
     memcpy(bitstream, NMEA0183Msg.Field(4), length);
-    fillBits=atoi(NMEA0183Msg.Field(5));
-    seqMessageId=atoi(NMEA0183Msg.Field(2));
-    pkgNmb=atoi(NMEA0183Msg.Field(1));
-    pkgCnt=atoi(NMEA0183Msg.Field(0));
-    channel = *NMEA0183Msg.Field(3);
+    fillBits=FieldToInt(NMEA0183Msg,5);
+    seqMessageId=FieldToInt(NMEA0183Msg,2);
+    pkgNmb=FieldToInt(NMEA0183Msg,1);
+    pkgCnt=FieldToInt(NMEA0183Msg,0);
+    channel = NMEA0183Msg.FieldChar(3);
     if (channel == '1') channel = 'A';
     if (channel == '2') channel = 'B';
   }
@@ -596,16 +611,16 @@ bool NMEA0183ParseVDM_nc(const tNMEA0183Msg &NMEA0183Msg,
 
 //*****************************************************************************
 //$GPRTE,2,1,c,0,W3IWI,DRIVWY,32CEDR,32-29,32BKLD,32-I95,32-US1,BW-32,BW-198*69
-bool NMEA0183ParseRTE_nc(const tNMEA0183Msg &NMEA0183Msg, tRTE &tRTE) {
+bool NMEA0183ParseRTE_nc(const tNMEA0183MsgView &NMEA0183Msg, tRTE &tRTE) {
 
     bool result=( NMEA0183Msg.FieldCount()>=4);
 
     if ( result ) {
 
-	 tRTE.nrOfsentences = atoi(NMEA0183Msg.Field(0));
-	 tRTE.currSentence = atoi(NMEA0183Msg.Field(1));
-	 tRTE.type = NMEA0183Msg.Field(2)[0];
-	 tRTE.routeID = atoi(NMEA0183Msg.Field(3));
+	 tRTE.nrOfsentences = FieldToInt(NMEA0183Msg,0);
+	 tRTE.currSentence = FieldToInt(NMEA0183Msg,1);
+	 tRTE.type = NMEA0183Msg.FieldChar(2);
+	 tRTE.routeID = FieldToInt(NMEA0183Msg,3);
 	 tRTE.nrOfwp = NMEA0183Msg.FieldCount() - 4;
 
 	 byte wpIndex=0;
@@ -622,32 +637,29 @@ bool NMEA0183ParseRTE_nc(const tNMEA0183Msg &NMEA0183Msg, tRTE &tRTE) {
 
 //*****************************************************************************
 //$GPWPL,5208.700,N,00438.600,E,MOLENB*4D
-bool NMEA0183ParseWPL_nc(const tNMEA0183Msg &NMEA0183Msg, tWPL &wpl) {
+bool NMEA0183ParseWPL_nc(const tNMEA0183MsgView &NMEA0183Msg, tWPL &wpl) {
 
     bool result=( NMEA0183Msg.FieldCount()>=5);
 
     if ( result ) {
-      wpl.latitude = LatLonToDouble(NMEA0183Msg.Field(0),NMEA0183Msg.Field(1)[0]);
-      wpl.longitude = LatLonToDouble(NMEA0183Msg.Field(2),NMEA0183Msg.Field(3)[0]);
-      strncpy(wpl.name,NMEA0183Msg.Field(4),sizeof(wpl.name)/sizeof(char));
-      wpl.name[sizeof(wpl.name)/sizeof(char)-1]='\0';
+      wpl.latitude = FieldToLatLon(NMEA0183Msg,0);
+      wpl.longitude = FieldToLatLon(NMEA0183Msg,2);
+      NMEA0183Msg.CopyField(4,wpl.name,sizeof(wpl.name)/sizeof(char));
 	  }
     return result;
 }
 
 //*****************************************************************************
 //$GPBOD,001.1,T,003.4,M,WETERB,WOUBRG*49
-bool NMEA0183ParseBOD_nc(const tNMEA0183Msg &NMEA0183Msg, tBOD &bod) {
+bool NMEA0183ParseBOD_nc(const tNMEA0183MsgView &NMEA0183Msg, tBOD &bod) {
 
     bool result=( NMEA0183Msg.FieldCount()>=6);
 
     if ( result ) {
-      bod.trueBearing = atof(NMEA0183Msg.Field(0))*degToRad;
-      bod.magBearing = atof(NMEA0183Msg.Field(2))*degToRad;
-      strncpy(bod.destID,NMEA0183Msg.Field(4),sizeof(bod.destID)/sizeof(char));
-      bod.destID[sizeof(bod.destID)/sizeof(char)-1]='\0';
-      strncpy(bod.originID,NMEA0183Msg.Field(5),sizeof(bod.originID)/sizeof(char));
-      bod.originID[sizeof(bod.originID)/sizeof(char)-1]='\0';
+      bod.trueBearing = FieldToDouble(NMEA0183Msg,0,degToRad);
+      bod.magBearing = FieldToDouble(NMEA0183Msg,2,degToRad);
+      NMEA0183Msg.CopyField(4,bod.destID,sizeof(bod.destID)/sizeof(char));
+      NMEA0183Msg.CopyField(5,bod.originID,sizeof(bod.originID)/sizeof(char));
 	  }
     return result;
 }
@@ -655,18 +667,18 @@ bool NMEA0183ParseBOD_nc(const tNMEA0183Msg &NMEA0183Msg, tBOD &bod) {
 //*****************************************************************************
 // MWV - Wind Speed and Angle
 //$IIMWV,120.1,R,9.5,M,A,a*hh
-bool NMEA0183ParseMWV_nc(const tNMEA0183Msg &NMEA0183Msg,double &WindAngle, tNMEA0183WindReference &Reference, double &WindSpeed) {
+bool NMEA0183ParseMWV_nc(const tNMEA0183MsgView &NMEA0183Msg,double &WindAngle, tNMEA0183WindReference &Reference, double &WindSpeed) {
   bool result=( NMEA0183Msg.FieldCount()>=4 );
 
   if ( result ) {
-    WindAngle=atof(NMEA0183Msg.Field(0));
-    switch ( NMEA0183Msg.Field(1)[0] ) {
+    WindAngle=FieldToDouble(NMEA0183Msg,0);
+    switch ( NMEA0183Msg.FieldChar(1) ) {
       case 'T' : Reference=NMEA0183Wind_True; break;
       case 'R' :
       default : Reference=NMEA0183Wind_Apparent; break;
     }
-    WindSpeed=atof(NMEA0183Msg.Field(2));
-    switch ( NMEA0183Msg.Field(3)[0] ) {
+    WindSpeed=FieldToDouble(NMEA0183Msg,2);
+    switch ( NMEA0183Msg.FieldChar(3) ) {
       case 'K' : WindSpeed*=kmhToms; break;
       case 'N' : WindSpeed*=knToms; break;
       case 'M' :
@@ -686,3 +698,232 @@ bool NMEA0183SetMWV(tNMEA0183Msg &NMEA0183Msg, double WindAngle, tNMEA0183WindRe
   if ( !NMEA0183Msg.AddStrField("A") ) return false;
   return true;
 }
+
+//*****************************************************************************
+// Fixed point helpers. These return NA for empty field.
+static int32_t FieldToFixed(const tNMEA0183MsgView &NMEA0183Msg, uint8_t index, uint8_t Decimals) {
+  int32_t val;
+
+  return ( NMEA0183FieldToFixed(NMEA0183Msg.Field(index),NMEA0183Msg.FieldLen(index),Decimals,val)?val:NMEA0183Int32NA );
+}
+
+//*****************************************************************************
+// Latitude or longitude on field index and sign on next field.
+static int32_t FieldToLatLonE7(const tNMEA0183MsgView &NMEA0183Msg, uint8_t index) {
+  int32_t val;
+
+  return ( NMEA0183FieldToLatLonE7(NMEA0183Msg.Field(index),NMEA0183Msg.FieldLen(index),NMEA0183Msg.FieldChar(index+1),val)?val:NMEA0183Int32NA );
+}
+
+//*****************************************************************************
+static uint32_t FieldToMilliSeconds(const tNMEA0183MsgView &NMEA0183Msg, uint8_t index) {
+  uint32_t val;
+
+  return ( NMEA0183FieldToMilliSeconds(NMEA0183Msg.Field(index),NMEA0183Msg.FieldLen(index),val)?val:NMEA0183UInt32NA );
+}
+
+//*****************************************************************************
+// Returns val*mul/div rounded half away from zero. NA will be kept.
+static int32_t ScaleFixed(int32_t val, int64_t mul, int64_t div) {
+  if ( val==NMEA0183Int32NA ) return val;
+
+  int64_t n=(int64_t)val*mul;
+  n=( n>=0 ? (n+div/2)/div : (n-div/2)/div );
+
+  return (int32_t)n;
+}
+
+// Unit conversions for ScaleFixed. Angle constants have 8 significant digits, so
+// that products fit to int64_t with any int32_t value.
+#define NMEA0183_DEGE4_TO_RADE4 17453293LL,1000000000LL
+#define NMEA0183_RADE4_TO_DEGE1 57295780LL,1000000000LL
+#define NMEA0183_KNE3_TO_MMS 1852LL,3600LL
+#define NMEA0183_KMHE3_TO_MMS 10LL,36LL
+#define NMEA0183_MMS_TO_KNE1 36LL,1852LL
+#define NMEA0183_MMS_TO_KMHE1 36LL,1000LL
+
+//*****************************************************************************
+// Convert angle in 1e-4 rad to 0.0-359.9 degrees in 1e-1 degrees. Reverse turns
+// angle by 180 degrees.
+static int32_t AngleToDegE1(int32_t Angle, bool Reverse=false) {
+  if ( Angle==NMEA0183Int32NA ) return Angle;
+
+  int32_t Deg=ScaleFixed(Angle,NMEA0183_RADE4_TO_DEGE1);
+  if ( Reverse ) Deg+=1800;
+  Deg%=3600;
+  if ( Deg<0 ) Deg+=3600;
+
+  return Deg;
+}
+
+//*****************************************************************************
+bool NMEA0183ParseGGAFixed_nc(const tNMEA0183MsgView &NMEA0183Msg, tGGAFixed &GGA) {
+  bool result=( NMEA0183Msg.FieldCount()>=14 );
+
+  if ( result ) {
+    GGA.TimeMs=FieldToMilliSeconds(NMEA0183Msg,0);
+    GGA.latitudeE7=FieldToLatLonE7(NMEA0183Msg,1);
+    GGA.longitudeE7=FieldToLatLonE7(NMEA0183Msg,3);
+    GGA.GPSQualityIndicator=FieldToFixed(NMEA0183Msg,5,0);
+    GGA.satelliteCount=FieldToFixed(NMEA0183Msg,6,0);
+    GGA.HDOP=FieldToFixed(NMEA0183Msg,7,2);
+    GGA.altitude=FieldToFixed(NMEA0183Msg,8,3);
+    GGA.geoidalSeparation=FieldToFixed(NMEA0183Msg,10,3);
+    int32_t DGPSAge=FieldToFixed(NMEA0183Msg,12,3);
+    GGA.DGPSAgeMs=( DGPSAge!=NMEA0183Int32NA && DGPSAge>=0 ? (uint32_t)DGPSAge : NMEA0183UInt32NA );
+    GGA.DGPSReferenceStationID=FieldToFixed(NMEA0183Msg,13,0);
+  }
+
+  return result;
+}
+
+//*****************************************************************************
+bool NMEA0183SetGGAFixed(tNMEA0183Msg &NMEA0183Msg, const tGGAFixed &GGA, const char *Src) {
+  if ( !NMEA0183Msg.Init("GGA",Src) ) return false;
+  if ( !NMEA0183Msg.AddTimeFieldMs(GGA.TimeMs) ) return false;
+  if ( !NMEA0183Msg.AddLatitudeFieldE7(GGA.latitudeE7) ) return false;
+  if ( !NMEA0183Msg.AddLongitudeFieldE7(GGA.longitudeE7) ) return false;
+  if ( !NMEA0183Msg.AddFixedField(GGA.GPSQualityIndicator,0) ) return false;
+  if ( !NMEA0183Msg.AddFixedField(GGA.satelliteCount,0) ) return false;
+  if ( !NMEA0183Msg.AddFixedField(ScaleFixed(GGA.HDOP,1,10),1) ) return false;
+  if ( !NMEA0183Msg.AddFixedField(ScaleFixed(GGA.altitude,1,100),1,"M") ) return false;
+  if ( !NMEA0183Msg.AddFixedField(ScaleFixed(GGA.geoidalSeparation,1,100),1,"M") ) return false;
+  if ( GGA.DGPSAgeMs!=NMEA0183UInt32NA ) {
+    if ( !NMEA0183Msg.AddFixedField((int32_t)((GGA.DGPSAgeMs+50)/100),1) ) return false;
+  } else {
+    if ( !NMEA0183Msg.AddEmptyField() ) return false;
+  }
+  if ( !NMEA0183Msg.AddFixedField(GGA.DGPSReferenceStationID,0) ) return false;
+
+  return true;
+}
+
+//*****************************************************************************
+bool NMEA0183ParseGLLFixed_nc(const tNMEA0183MsgView &NMEA0183Msg, tGLLFixed &GLL) {
+  bool result=( NMEA0183Msg.FieldCount()>=6 );
+
+  if ( result ) {
+    GLL.latitudeE7=FieldToLatLonE7(NMEA0183Msg,0);
+    GLL.longitudeE7=FieldToLatLonE7(NMEA0183Msg,2);
+    GLL.TimeMs=FieldToMilliSeconds(NMEA0183Msg,4);
+    GLL.status=NMEA0183Msg.FieldChar(5);
+  }
+
+  return result;
+}
+
+//*****************************************************************************
+bool NMEA0183SetGLLFixed(tNMEA0183Msg &NMEA0183Msg, uint32_t TimeMs, int32_t LatitudeE7, int32_t LongitudeE7, const char *Src) {
+  if ( !NMEA0183Msg.Init("GLL",Src) ) return false;
+  if ( !NMEA0183Msg.AddLatitudeFieldE7(LatitudeE7) ) return false;
+  if ( !NMEA0183Msg.AddLongitudeFieldE7(LongitudeE7) ) return false;
+  if ( !NMEA0183Msg.AddTimeFieldMs(TimeMs) ) return false;
+  bool Valid=( TimeMs!=NMEA0183UInt32NA && LatitudeE7!=NMEA0183Int32NA && LongitudeE7!=NMEA0183Int32NA );
+
+  return NMEA0183Msg.AddStrField(Valid?"A":"V");
+}
+
+//*****************************************************************************
+bool NMEA0183ParseRMCFixed_nc(const tNMEA0183MsgView &NMEA0183Msg, tRMCFixed &RMC) {
+  bool result=( NMEA0183Msg.FieldCount()>=11 );
+
+  if ( result ) {
+    RMC.TimeMs=FieldToMilliSeconds(NMEA0183Msg,0);
+    RMC.status=NMEA0183Msg.FieldChar(1);
+    RMC.latitudeE7=FieldToLatLonE7(NMEA0183Msg,2);
+    RMC.longitudeE7=FieldToLatLonE7(NMEA0183Msg,4);
+    RMC.SOG=ScaleFixed(FieldToFixed(NMEA0183Msg,6,3),NMEA0183_KNE3_TO_MMS);
+    RMC.trueCOG=ScaleFixed(FieldToFixed(NMEA0183Msg,7,4),NMEA0183_DEGE4_TO_RADE4);
+    if ( NMEA0183Msg.FieldLen(8)==6 ) {
+      char DateStr[7];
+      NMEA0183Msg.CopyField(8,DateStr,sizeof(DateStr));
+      time_t DT=NMEA0183GPSDateTimetotime_t(DateStr,0);
+      if ( RMC.TimeMs!=NMEA0183UInt32NA ) DT+=RMC.TimeMs/1000;
+      RMC.daysSince1970=tNMEA0183Msg::elapsedDaysSince1970(DT);
+    } else {
+      RMC.daysSince1970=NMEA0183UInt32NA;
+    }
+    RMC.variation=ScaleFixed(FieldToFixed(NMEA0183Msg,9,4),NMEA0183_DEGE4_TO_RADE4);
+    if ( RMC.variation!=NMEA0183Int32NA && NMEA0183Msg.FieldChar(10)=='W' ) RMC.variation=-RMC.variation;
+  }
+
+  return result;
+}
+
+//*****************************************************************************
+bool NMEA0183SetRMCFixed(tNMEA0183Msg &NMEA0183Msg, const tRMCFixed &RMC, const char *Src) {
+  bool Reverse=( RMC.SOG!=NMEA0183Int32NA && RMC.SOG<0 );
+  int32_t SOG=( Reverse ? -RMC.SOG : RMC.SOG );
+
+  if ( !NMEA0183Msg.Init("RMC",Src) ) return false;
+  if ( !NMEA0183Msg.AddTimeFieldMs(RMC.TimeMs) ) return false;
+  // Status 0 means not set, so then valid time tells that fix is valid.
+  char Status[2]={ RMC.status, 0 };
+  if ( Status[0]!='A' && Status[0]!='V' ) Status[0]=( RMC.TimeMs!=NMEA0183UInt32NA ? 'A' : 0 );
+  if ( !NMEA0183Msg.AddStrField(Status) ) return false;
+  if ( !NMEA0183Msg.AddLatitudeFieldE7(RMC.latitudeE7) ) return false;
+  if ( !NMEA0183Msg.AddLongitudeFieldE7(RMC.longitudeE7) ) return false;
+  if ( !NMEA0183Msg.AddFixedField(ScaleFixed(SOG,NMEA0183_MMS_TO_KNE1),1) ) return false;
+  if ( !NMEA0183Msg.AddFixedField(AngleToDegE1(RMC.trueCOG,Reverse),1) ) return false;
+  if ( !NMEA0183Msg.AddDaysField(RMC.daysSince1970) ) return false;
+  if ( RMC.variation!=NMEA0183Int32NA ) {
+    if ( !NMEA0183Msg.AddFixedField(ScaleFixed(RMC.variation>=0?RMC.variation:-RMC.variation,NMEA0183_RADE4_TO_DEGE1),1) ) return false;
+    if ( !NMEA0183Msg.AddStrField(RMC.variation>=0?"E":"W") ) return false;
+  } else {
+    if ( !NMEA0183Msg.AddEmptyField() ) return false;
+    if ( !NMEA0183Msg.AddEmptyField() ) return false;
+  }
+
+  return true;
+}
+
+//*****************************************************************************
+bool NMEA0183ParseVTGFixed_nc(const tNMEA0183MsgView &NMEA0183Msg, int32_t &TrueCOG, int32_t &MagneticCOG, int32_t &SOG) {
+  bool result=( NMEA0183Msg.FieldCount()>=8 );
+
+  if ( result ) {
+    TrueCOG=ScaleFixed(FieldToFixed(NMEA0183Msg,0,4),NMEA0183_DEGE4_TO_RADE4);
+    MagneticCOG=ScaleFixed(FieldToFixed(NMEA0183Msg,2,4),NMEA0183_DEGE4_TO_RADE4);
+    if (NMEA0183Msg.FieldLen(6)!=0) {  // km/h is valid
+      SOG=ScaleFixed(FieldToFixed(NMEA0183Msg,6,3),NMEA0183_KMHE3_TO_MMS);
+    } else {
+      SOG=ScaleFixed(FieldToFixed(NMEA0183Msg,4,3),NMEA0183_KNE3_TO_MMS);
+    }
+  }
+
+  return result;
+}
+
+//*****************************************************************************
+bool NMEA0183SetVTGFixed(tNMEA0183Msg &NMEA0183Msg, int32_t TrueCOG, int32_t MagneticCOG, int32_t SOG, const char *Src) {
+  bool Reverse=( SOG!=NMEA0183Int32NA && SOG<0 );
+  if ( Reverse ) SOG=-SOG;
+
+  if ( !NMEA0183Msg.Init("VTG",Src) ) return false;
+  if ( !NMEA0183Msg.AddFixedField(AngleToDegE1(TrueCOG,Reverse),1,"T") ) return false;
+  if ( !NMEA0183Msg.AddFixedField(AngleToDegE1(MagneticCOG,Reverse),1,"M") ) return false;
+  if ( !NMEA0183Msg.AddFixedField(ScaleFixed(SOG,NMEA0183_MMS_TO_KNE1),1,"N") ) return false;
+  if ( !NMEA0183Msg.AddFixedField(ScaleFixed(SOG,NMEA0183_MMS_TO_KMHE1),1,"K") ) return false;
+
+  return true;
+}
+
+//*****************************************************************************
+bool NMEA0183ParseHDTFixed_nc(const tNMEA0183MsgView &NMEA0183Msg, int32_t &TrueHeading) {
+  bool result=( NMEA0183Msg.FieldCount()>=2 );
+
+  if ( result ) {
+    TrueHeading=ScaleFixed(FieldToFixed(NMEA0183Msg,0,4),NMEA0183_DEGE4_TO_RADE4);
+  }
+
+  return result;
+}
+
+//*****************************************************************************
+bool NMEA0183SetHDTFixed(tNMEA0183Msg &NMEA0183Msg, int32_t Heading, const char *Src) {
+  if ( !NMEA0183Msg.Init("HDT",Src) ) return false;
+  if ( !NMEA0183Msg.AddFixedField(AngleToDegE1(Heading),1) ) return false;
+  if ( !NMEA0183Msg.AddStrField("T") ) return false;
+
+  return true;
+}
@@ -27,11 +27,34 @@ OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <stdio.h>
 #include <time.h>
 #include <NMEA0183Msg.h>
+#include <NMEA0183MsgView.h>
 
 #ifndef Arduino
 typedef uint8_t byte;
 #endif
 
+// Parse functions take view. Message given to them will be converted to default view, which
+// holds MAX_NMEA0183_MSG_FIELDS fields, so parsing tNMEA0183MsgT with more fields fails.
+// Use tNMEA0183MsgViewT for it, e.g. tNMEA0183MsgViewT<40> View(RTEMsg); NMEA0183ParseRTE(View,rte);
+
+// Message code ids for supported messages. These can be used e.g. on switch ( Msg.MessageCodeId() ).
+constexpr uint32_t NMEA0183MsgCodeDPT=NMEA0183MsgCodeId("DPT");
+constexpr uint32_t NMEA0183MsgCodeGGA=NMEA0183MsgCodeId("GGA");
+constexpr uint32_t NMEA0183MsgCodeGLL=NMEA0183MsgCodeId("GLL");
+constexpr uint32_t NMEA0183MsgCodeRMB=NMEA0183MsgCodeId("RMB");
+constexpr uint32_t NMEA0183MsgCodeRMC=NMEA0183MsgCodeId("RMC");
+constexpr uint32_t NMEA0183MsgCodeVTG=NMEA0183MsgCodeId("VTG");
+constexpr uint32_t NMEA0183MsgCodeVHW=NMEA0183MsgCodeId("VHW");
+constexpr uint32_t NMEA0183MsgCodeROT=NMEA0183MsgCodeId("ROT");
+constexpr uint32_t NMEA0183MsgCodeHDT=NMEA0183MsgCodeId("HDT");
+constexpr uint32_t NMEA0183MsgCodeHDM=NMEA0183MsgCodeId("HDM");
+constexpr uint32_t NMEA0183MsgCodeHDG=NMEA0183MsgCodeId("HDG");
+constexpr uint32_t NMEA0183MsgCodeVDM=NMEA0183MsgCodeId("VDM");
+constexpr uint32_t NMEA0183MsgCodeRTE=NMEA0183MsgCodeId("RTE");
+constexpr uint32_t NMEA0183MsgCodeWPL=NMEA0183MsgCodeId("WPL");
+constexpr uint32_t NMEA0183MsgCodeBOD=NMEA0183MsgCodeId("BOD");
+constexpr uint32_t NMEA0183MsgCodeMWV=NMEA0183MsgCodeId("MWV");
+
 #define NMEA0183_MAX_WP_NAME_LENGTH 20
 //The $GPRTE,2,1,c,0, ... *69 part takes up 18 characters. Need additional character for the null terminator of the last string.
 #define NMEA0183_RTE_WPLENGTH MAX_NMEA0183_MSG_LEN-18+1
@@ -170,19 +193,19 @@ bool NMEA0183SetDPT(tNMEA0183Msg &NMEA0183Msg, double DepthBelowTransducer, doub
 
 
 //*****************************************************************************
-bool NMEA0183ParseGGA_nc(const tNMEA0183Msg &NMEA0183Msg, double &GPSTime, double &Latitude, double &Longitude,
+bool NMEA0183ParseGGA_nc(const tNMEA0183MsgView &NMEA0183Msg, double &GPSTime, double &Latitude, double &Longitude,
                       int &GPSQualityIndicator, int &SatelliteCount, double &HDOP, double &Altitude, double &GeoidalSeparation,
                       double &DGPSAge, int &DGPSReferenceStationID);
 
-inline bool NMEA0183ParseGGA(const tNMEA0183Msg &NMEA0183Msg, double &GPSTime, double &Latitude, double &Longitude,
+inline bool NMEA0183ParseGGA(const tNMEA0183MsgView &NMEA0183Msg, double &GPSTime, double &Latitude, double &Longitude,
                       int &GPSQualityIndicator, int &SatelliteCount, double &HDOP, double &Altitude, double &GeoidalSeparation,
                       double &DGPSAge, int &DGPSReferenceStationID) {
-  return (NMEA0183Msg.IsMessageCode("GGA")
+  return (NMEA0183Msg.IsMessageCodeId(NMEA0183MsgCodeGGA)
             ?NMEA0183ParseGGA_nc(NMEA0183Msg,GPSTime,Latitude,Longitude,GPSQualityIndicator,SatelliteCount,HDOP,Altitude,GeoidalSeparation,DGPSAge,DGPSReferenceStationID)
             :false);
 }
 
-inline bool NMEA0183ParseGGA(const tNMEA0183Msg &NMEA0183Msg, tGGA &gga) {
+inline bool NMEA0183ParseGGA(const tNMEA0183MsgView &NMEA0183Msg, tGGA &gga) {
 
 	return NMEA0183ParseGGA(NMEA0183Msg,gga.GPSTime,gga.latitude,gga.longitude,gga.GPSQualityIndicator,
 										gga.satelliteCount,gga.HDOP,gga.altitude,gga.geoidalSeparation,gga.DGPSAge,gga.DGPSReferenceStationID);
@@ -195,10 +218,10 @@ bool NMEA0183SetGGA(tNMEA0183Msg &NMEA0183Msg, double GPSTime, double Latitude,
 
 
 //*****************************************************************************
-bool NMEA0183ParseGLL_nc(const tNMEA0183Msg &NMEA0183Msg, tGLL &gll);
+bool NMEA0183ParseGLL_nc(const tNMEA0183MsgView &NMEA0183Msg, tGLL &gll);
 
-inline bool NMEA0183ParseGLL(const tNMEA0183Msg &NMEA0183Msg, tGLL &gll) {
-  return (NMEA0183Msg.IsMessageCode("GLL")
+inline bool NMEA0183ParseGLL(const tNMEA0183MsgView &NMEA0183Msg, tGLL &gll) {
+  return (NMEA0183Msg.IsMessageCodeId(NMEA0183MsgCodeGLL)
             ?NMEA0183ParseGLL_nc(NMEA0183Msg,gll)
             :false);
 }
@@ -207,27 +230,27 @@ inline bool NMEA0183ParseGLL(const tNMEA0183Msg &NMEA0183Msg, tGLL &gll) {
 bool NMEA0183SetGLL(tNMEA0183Msg &NMEA0183Msg, double GPSTime, double Latitude, double Longitude, const char *Src="GP");
 
 //*****************************************************************************
-bool NMEA0183ParseRMB_nc(const tNMEA0183Msg &NMEA0183Msg, tRMB &rmb);
+bool NMEA0183ParseRMB_nc(const tNMEA0183MsgView &NMEA0183Msg, tRMB &rmb);
 
-inline bool NMEA0183ParseRMB(const tNMEA0183Msg &NMEA0183Msg, tRMB &rmb) {
-    return (NMEA0183Msg.IsMessageCode("RMB") ?
+inline bool NMEA0183ParseRMB(const tNMEA0183MsgView &NMEA0183Msg, tRMB &rmb) {
+    return (NMEA0183Msg.IsMessageCodeId(NMEA0183MsgCodeRMB) ?
         NMEA0183ParseRMB_nc(NMEA0183Msg, rmb) : false);
 }
 
 //*****************************************************************************
 // RMC
-bool NMEA0183ParseRMC_nc(const tNMEA0183Msg &NMEA0183Msg, double &GPSTime, double &Latitude, double &Longitude,
+bool NMEA0183ParseRMC_nc(const tNMEA0183MsgView &NMEA0183Msg, double &GPSTime, double &Latitude, double &Longitude,
                       double &TrueCOG, double &SOG, unsigned long &DaysSince1970, double &Variation, time_t *DateTime=0);
 
-inline bool NMEA0183ParseRMC(const tNMEA0183Msg &NMEA0183Msg, double &GPSTime, double &Latitude, double &Longitude,
+inline bool NMEA0183ParseRMC(const tNMEA0183MsgView &NMEA0183Msg, double &GPSTime, double &Latitude, double &Longitude,
                       double &TrueCOG, double &SOG, unsigned long &DaysSince1970, double &Variation, time_t *DateTime=0) {
   (void)DateTime;
-  return (NMEA0183Msg.IsMessageCode("RMC")
+  return (NMEA0183Msg.IsMessageCodeId(NMEA0183MsgCodeRMC)
             ?NMEA0183ParseRMC_nc(NMEA0183Msg, GPSTime, Latitude, Longitude, TrueCOG, SOG, DaysSince1970, Variation, DateTime)
             :false);
 }
 
-inline bool NMEA0183ParseRMC(const tNMEA0183Msg &NMEA0183Msg, tRMC &rmc, time_t *DateTime=0) {
+inline bool NMEA0183ParseRMC(const tNMEA0183MsgView &NMEA0183Msg, tRMC &rmc, time_t *DateTime=0) {
 
 	return NMEA0183ParseRMC(NMEA0183Msg, rmc.GPSTime, rmc.latitude, rmc.longitude, rmc.trueCOG, rmc.SOG, rmc.daysSince1970, rmc.variation, DateTime);
 }
@@ -238,10 +261,10 @@ bool NMEA0183SetRMC(tNMEA0183Msg &NMEA0183Msg, double GPSTime, double Latitude,
 //*****************************************************************************
 // COG will be returned be in radians
 // SOG will be returned in m/s
-bool NMEA0183ParseVTG_nc(const tNMEA0183Msg &NMEA0183Msg, double &TrueCOG, double &MagneticCOG, double &SOG);
+bool NMEA0183ParseVTG_nc(const tNMEA0183MsgView &NMEA0183Msg, double &TrueCOG, double &MagneticCOG, double &SOG);
 
-inline bool NMEA0183ParseVTG(const tNMEA0183Msg &NMEA0183Msg, double &TrueCOG, double &MagneticCOG, double &SOG) {
-  return (NMEA0183Msg.IsMessageCode("VTG")
+inline bool NMEA0183ParseVTG(const tNMEA0183MsgView &NMEA0183Msg, double &TrueCOG, double &MagneticCOG, double &SOG) {
+  return (NMEA0183Msg.IsMessageCodeId(NMEA0183MsgCodeVTG)
             ?NMEA0183ParseVTG_nc(NMEA0183Msg,TrueCOG,MagneticCOG,SOG)
             :false);
 }
@@ -254,10 +277,10 @@ bool NMEA0183BuildVTG(char* msg, const char Src[], double TrueCOG, double Magnet
 //*****************************************************************************
 // TrueHeading,MagneticHeading will be returned be in radians
 // SOW will be returned in m/s
-bool NMEA0183ParseVHW_nc(const tNMEA0183Msg &NMEA0183Msg, double &TrueHeading, double &MagneticHeading, double &SOW);
+bool NMEA0183ParseVHW_nc(const tNMEA0183MsgView &NMEA0183Msg, double &TrueHeading, double &MagneticHeading, double &SOW);
 
-inline bool NMEA0183ParseVHW(const tNMEA0183Msg &NMEA0183Msg, double &TrueHeading, double &MagneticHeading, double &SOW) {
-  return (NMEA0183Msg.IsMessageCode("VHW")
+inline bool NMEA0183ParseVHW(const tNMEA0183MsgView &NMEA0183Msg, double &TrueHeading, double &MagneticHeading, double &SOW) {
+  return (NMEA0183Msg.IsMessageCodeId(NMEA0183MsgCodeVHW)
             ?NMEA0183ParseVHW_nc(NMEA0183Msg,TrueHeading,MagneticHeading,SOW)
             :false);
 }
@@ -266,10 +289,10 @@ bool NMEA0183SetVHW(tNMEA0183Msg &NMEA0183Msg, double TrueHeading, double Magnet
 
 //*****************************************************************************
 // Rate of turn will be returned be in radians
-bool NMEA0183ParseROT_nc(const tNMEA0183Msg &NMEA0183Msg,double &RateOfTurn);
+bool NMEA0183ParseROT_nc(const tNMEA0183MsgView &NMEA0183Msg,double &RateOfTurn);
 
-inline bool NMEA0183ParseROT(const tNMEA0183Msg &NMEA0183Msg, double &RateOfTurn) {
-  return (NMEA0183Msg.IsMessageCode("ROT")
+inline bool NMEA0183ParseROT(const tNMEA0183MsgView &NMEA0183Msg, double &RateOfTurn) {
+  return (NMEA0183Msg.IsMessageCodeId(NMEA0183MsgCodeROT)
             ?NMEA0183ParseROT_nc(NMEA0183Msg,RateOfTurn)
             :false);
 }
@@ -278,10 +301,10 @@ bool NMEA0183SetROT(tNMEA0183Msg &NMEA0183Msg, double RateOfTurn, const char *Sr
 
 //*****************************************************************************
 // Heading will be returned be in radians
-bool NMEA0183ParseHDT_nc(const tNMEA0183Msg &NMEA0183Msg,double &TrueHeading);
+bool NMEA0183ParseHDT_nc(const tNMEA0183MsgView &NMEA0183Msg,double &TrueHeading);
 
-inline bool NMEA0183ParseHDT(const tNMEA0183Msg &NMEA0183Msg, double &TrueHeading) {
-  return (NMEA0183Msg.IsMessageCode("HDT")
+inline bool NMEA0183ParseHDT(const tNMEA0183MsgView &NMEA0183Msg, double &TrueHeading) {
+  return (NMEA0183Msg.IsMessageCodeId(NMEA0183MsgCodeHDT)
             ?NMEA0183ParseHDT_nc(NMEA0183Msg,TrueHeading)
             :false);
 }
@@ -290,10 +313,10 @@ bool NMEA0183SetHDT(tNMEA0183Msg &NMEA0183Msg, double Heading, const char *Src="
 
 //*****************************************************************************
 // Heading will be returned be in radians
-bool NMEA0183ParseHDM_nc(const tNMEA0183Msg &NMEA0183Msg,double &MagneticHeading);
+bool NMEA0183ParseHDM_nc(const tNMEA0183MsgView &NMEA0183Msg,double &MagneticHeading);
 
-inline bool NMEA0183ParseHDM(const tNMEA0183Msg &NMEA0183Msg, double &MagneticHeading) {
-  return (NMEA0183Msg.IsMessageCode("HDM")
+inline bool NMEA0183ParseHDM(const tNMEA0183MsgView &NMEA0183Msg, double &MagneticHeading) {
+  return (NMEA0183Msg.IsMessageCodeId(NMEA0183MsgCodeHDM)
             ?NMEA0183ParseHDT_nc(NMEA0183Msg,MagneticHeading)
             :false);
 }
@@ -305,17 +328,17 @@ bool NMEA0183SetHDG(tNMEA0183Msg &NMEA0183Msg, double Heading, double Deviation,
 
 //*****************************************************************************
 // VDM is basically a bitstream
-bool NMEA0183ParseVDM_nc(const tNMEA0183Msg &NMEA0183Msg,
+bool NMEA0183ParseVDM_nc(const tNMEA0183MsgView &NMEA0183Msg,
 			uint8_t &pkgCnt, uint8_t &pkgNmb,
 			unsigned int &seqMessageId, char &channel,
 			unsigned int &length, char *bitstream,
 			unsigned int &fillBits);
 
 
-inline bool NMEA0183ParseVDM(const tNMEA0183Msg &NMEA0183Msg, uint8_t &pkgCnt, uint8_t &pkgNmb,
+inline bool NMEA0183ParseVDM(const tNMEA0183MsgView &NMEA0183Msg, uint8_t &pkgCnt, uint8_t &pkgNmb,
 						unsigned int &seqMessageId, char &channel,
 						unsigned int &length, char* bitstream, unsigned int &fillBits) {
-  return (NMEA0183Msg.IsMessageCode("VDM") ?
+  return (NMEA0183Msg.IsMessageCodeId(NMEA0183MsgCodeVDM) ?
 		NMEA0183ParseVDM_nc(NMEA0183Msg, pkgCnt, pkgNmb, seqMessageId, channel, length, bitstream, fillBits) : false);
 }
 
@@ -325,40 +348,139 @@ inline bool NMEA0183ParseVDM(const tNMEA0183Msg &NMEA0183Msg, uint8_t &pkgCnt, u
 //This method only handles a single RTE message. Handling a sequence of RTE messages is outside of the scope of this lib.
 //This should be handled in the calling lib. An example lib which handles a sequence of RTE messages can be found here: https://github.com/tonswieb/NMEAGateway
 //$GPRTE,2,1,c,0,W3IWI,DRIVWY,32CEDR,32-29,32BKLD,32-I95,32-US1,BW-32,BW-198*69
-bool NMEA0183ParseRTE_nc(const tNMEA0183Msg &NMEA0183Msg, tRTE &rte);
+bool NMEA0183ParseRTE_nc(const tNMEA0183MsgView &NMEA0183Msg, tRTE &rte);
 
-inline bool NMEA0183ParseRTE(const tNMEA0183Msg &NMEA0183Msg, tRTE &rte) {
-	return (NMEA0183Msg.IsMessageCode("RTE") ?
+inline bool NMEA0183ParseRTE(const tNMEA0183MsgView &NMEA0183Msg, tRTE &rte) {
+	return (NMEA0183Msg.IsMessageCodeId(NMEA0183MsgCodeRTE) ?
 					NMEA0183ParseRTE_nc(NMEA0183Msg,rte) : false);
 }
 
 //*****************************************************************************
 //$GPWPL,5208.700,N,00438.600,E,MOLENB*4D
-bool NMEA0183ParseWPL_nc(const tNMEA0183Msg &NMEA0183Msg, tWPL &wpl);
+bool NMEA0183ParseWPL_nc(const tNMEA0183MsgView &NMEA0183Msg, tWPL &wpl);
 
-inline bool NMEA0183ParseWPL(const tNMEA0183Msg &NMEA0183Msg, tWPL &wpl) {
-	return (NMEA0183Msg.IsMessageCode("WPL") ?
+inline bool NMEA0183ParseWPL(const tNMEA0183MsgView &NMEA0183Msg, tWPL &wpl) {
+	return (NMEA0183Msg.IsMessageCodeId(NMEA0183MsgCodeWPL) ?
 					NMEA0183ParseWPL_nc(NMEA0183Msg,wpl) : false);
 }
 
 //*****************************************************************************
-bool NMEA0183ParseBOD_nc(const tNMEA0183Msg &NMEA0183Msg, tBOD &bod);
+bool NMEA0183ParseBOD_nc(const tNMEA0183MsgView &NMEA0183Msg, tBOD &bod);
 
-inline bool NMEA0183ParseBOD(const tNMEA0183Msg &NMEA0183Msg, tBOD &bod) {
-	return (NMEA0183Msg.IsMessageCode("BOD") ?
+inline bool NMEA0183ParseBOD(const tNMEA0183MsgView &NMEA0183Msg, tBOD &bod) {
+	return (NMEA0183Msg.IsMessageCodeId(NMEA0183MsgCodeBOD) ?
 					NMEA0183ParseBOD_nc(NMEA0183Msg,bod) : false);
 }
 
 //*****************************************************************************
 // MWV - Wind Speed and Angle
-bool NMEA0183ParseMWV_nc(const tNMEA0183Msg &NMEA0183Msg,double &WindAngle, tNMEA0183WindReference &Reference, double &WindSpeed);
+bool NMEA0183ParseMWV_nc(const tNMEA0183MsgView &NMEA0183Msg,double &WindAngle, tNMEA0183WindReference &Reference, double &WindSpeed);
 
-inline bool NMEA0183ParseMWV(const tNMEA0183Msg &NMEA0183Msg,double &WindAngle, tNMEA0183WindReference &Reference, double &WindSpeed) {
-  return (NMEA0183Msg.IsMessageCode("MWV")
+inline bool NMEA0183ParseMWV(const tNMEA0183MsgView &NMEA0183Msg,double &WindAngle, tNMEA0183WindReference &Reference, double &WindSpeed) {
+  return (NMEA0183Msg.IsMessageCodeId(NMEA0183MsgCodeMWV)
             ?NMEA0183ParseMWV_nc(NMEA0183Msg,WindAngle,Reference,WindSpeed)
             :false);
 }
 
 bool NMEA0183SetMWV(tNMEA0183Msg &NMEA0183Msg, double WindAngle, tNMEA0183WindReference Reference, double WindSpeed, const char *Src="II");
 
+//*****************************************************************************
+// Fixed point versions of functions above. These are for systems without FPU.
+// Units are:
+//   - latitude and longitude in 1e-7 degrees
+//   - time in milliseconds since midnight
+//   - angles in 1e-4 radians
+//   - speeds in mm/s
+//   - distances in mm
+// Empty field will be returned as NMEA0183Int32NA or NMEA0183UInt32NA and
+// they can be also used on Set functions.
+
+struct tGGAFixed {
+  uint32_t TimeMs;
+  int32_t latitudeE7;
+  int32_t longitudeE7;
+  int32_t GPSQualityIndicator;
+  int32_t satelliteCount;
+  int32_t HDOP; // 1e-2
+  int32_t altitude;
+  int32_t geoidalSeparation;
+  uint32_t DGPSAgeMs;
+  int32_t DGPSReferenceStationID;
+};
+
+struct tGLLFixed {
+  uint32_t TimeMs;
+  int32_t latitudeE7;
+  int32_t longitudeE7;
+  //'A' = OK, 'V' = Void (warning)
+  char status;
+};
+
+struct tRMCFixed {
+  //'A' = OK, 'V' = Void (warning)
+  char status;
+  uint32_t TimeMs;
+  int32_t latitudeE7;
+  int32_t longitudeE7;
+  int32_t trueCOG;
+  int32_t SOG;
+  unsigned long daysSince1970;
+  int32_t variation;
+};
+
+//*****************************************************************************
+bool NMEA0183ParseGGAFixed_nc(const tNMEA0183MsgView &NMEA0183Msg, tGGAFixed &gga);
+
+inline bool NMEA0183ParseGGAFixed(const tNMEA0183MsgView &NMEA0183Msg, tGGAFixed &gga) {
+  return (NMEA0183Msg.IsMessageCodeId(NMEA0183MsgCodeGGA)
+            ?NMEA0183ParseGGAFixed_nc(NMEA0183Msg,gga)
+            :false);
+}
+
+bool NMEA0183SetGGAFixed(tNMEA0183Msg &NMEA0183Msg, const tGGAFixed &gga, const char *Src="GP");
+
+//*****************************************************************************
+bool NMEA0183ParseGLLFixed_nc(const tNMEA0183MsgView &NMEA0183Msg, tGLLFixed &gll);
+
+inline bool NMEA0183ParseGLLFixed(const tNMEA0183MsgView &NMEA0183Msg, tGLLFixed &gll) {
+  return (NMEA0183Msg.IsMessageCodeId(NMEA0183MsgCodeGLL)
+            ?NMEA0183ParseGLLFixed_nc(NMEA0183Msg,gll)
+            :false);
+}
+
+bool NMEA0183SetGLLFixed(tNMEA0183Msg &NMEA0183Msg, uint32_t TimeMs, int32_t LatitudeE7, int32_t LongitudeE7, const char *Src="GP");
+
+//*****************************************************************************
+bool NMEA0183ParseRMCFixed_nc(const tNMEA0183MsgView &NMEA0183Msg, tRMCFixed &rmc);
+
+inline bool NMEA0183ParseRMCFixed(const tNMEA0183MsgView &NMEA0183Msg, tRMCFixed &rmc) {
+  return (NMEA0183Msg.IsMessageCodeId(NMEA0183MsgCodeRMC)
+            ?NMEA0183ParseRMCFixed_nc(NMEA0183Msg,rmc)
+            :false);
+}
+
+bool NMEA0183SetRMCFixed(tNMEA0183Msg &NMEA0183Msg, const tRMCFixed &rmc, const char *Src="GP");
+
+//*****************************************************************************
+bool NMEA0183ParseVTGFixed_nc(const tNMEA0183MsgView &NMEA0183Msg, int32_t &TrueCOG, int32_t &MagneticCOG, int32_t &SOG);
+
+inline bool NMEA0183ParseVTGFixed(const tNMEA0183MsgView &NMEA0183Msg, int32_t &TrueCOG, int32_t &MagneticCOG, int32_t &SOG) {
+  return (NMEA0183Msg.IsMessageCodeId(NMEA0183MsgCodeVTG)
+            ?NMEA0183ParseVTGFixed_nc(NMEA0183Msg,TrueCOG,MagneticCOG,SOG)
+            :false);
+}
+
+bool NMEA0183SetVTGFixed(tNMEA0183Msg &NMEA0183Msg, int32_t TrueCOG, int32_t MagneticCOG, int32_t SOG, const char *Src="GP");
+
+//*****************************************************************************
+bool NMEA0183ParseHDTFixed_nc(const tNMEA0183MsgView &NMEA0183Msg, int32_t &TrueHeading);
+
+inline bool NMEA0183ParseHDTFixed(const tNMEA0183MsgView &NMEA0183Msg, int32_t &TrueHeading) {
+  return (NMEA0183Msg.IsMessageCodeId(NMEA0183MsgCodeHDT)
+            ?NMEA0183ParseHDTFixed_nc(NMEA0183Msg,TrueHeading)
+            :false);
+}
+
+bool NMEA0183SetHDTFixed(tNMEA0183Msg &NMEA0183Msg, int32_t Heading, const char *Src="GP");
+
 #endif
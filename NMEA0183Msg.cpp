@@ -23,25 +23,13 @@ OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 
 #include <math.h>
-#ifndef ARDUINO
-#include <cstdio>
-#endif
 #include "NMEA0183Msg.h"
+#include "NMEA0183Scan.h"
 
 #ifndef SECS_PER_DAY
 #define SECS_PER_DAY 86400UL
 #endif
 
-// Teensy 3.2, 3.5, 3.6
-// Arduino Mega
-// Linux
-#if !( defined(__MK20DX256__)||defined(__ATMEGA32U4__) || defined(__MK64FX512__) || defined (__MK66FX1M0__) \
-       || defined(__SAM3X8E__) \
-       || defined(__linux__)||defined(__linux)||defined(linux) \
-     )
-#define NO_PRINTF_DOUBLE_SUPPORT
-#endif
-
 #ifndef ARDUINO
 extern "C" {
 // Application execution delay. Must be implemented by application.
@@ -56,65 +44,161 @@ const char *tNMEA0183Msg::EmptyField="";
 const char *tNMEA0183Msg::DefDoubleFormat="%.1f";
 
 //*****************************************************************************
-tNMEA0183Msg::tNMEA0183Msg() {
+uint32_t NMEA0183MsgCodeId(const char *code, size_t len) {
+  if ( code==0 || len>NMEA0183_MAX_CODE_ID_LEN ) return 0;
+
+  uint32_t Id=0;
+  for ( size_t i=0; i<len; i++ ) {
+    uint32_t c=NMEA0183IdChar(code[i]);
+    if ( c==0 ) return 0;
+    Id|=c<<(6*i);
+  }
+
+  return Id;
+}
+
+//*****************************************************************************
+tNMEA0183Msg::tNMEA0183Msg()
+: Data(DefaultData), Fields(DefaultFields), DataSize(MAX_NMEA0183_MSG_LEN), MaxFields(MAX_NMEA0183_MSG_FIELDS) {
   Clear();
 }
 
 //*****************************************************************************
-bool tNMEA0183Msg::SetMessage(const char *buf) {
-  unsigned char csMsg;
-  int i=0;
-  uint8_t iData=0;
-  bool result=false;
+tNMEA0183Msg::tNMEA0183Msg(const tNMEA0183Msg &NMEA0183Msg)
+: Data(DefaultData), Fields(DefaultFields), DataSize(MAX_NMEA0183_MSG_LEN), MaxFields(MAX_NMEA0183_MSG_FIELDS) {
+  CopyFrom(NMEA0183Msg);
+}
+
+//*****************************************************************************
+tNMEA0183Msg &tNMEA0183Msg::operator=(const tNMEA0183Msg &NMEA0183Msg) {
+  CopyFrom(NMEA0183Msg);
+  return *this;
+}
 
+//*****************************************************************************
+void tNMEA0183Msg::SetStorage(char *_Data, uint8_t _DataSize, uint8_t *_Fields, uint8_t _MaxFields) {
+  Data=_Data;
+  DataSize=_DataSize;
+  Fields=_Fields;
+  MaxFields=_MaxFields;
   Clear();
-  _MessageTime=millis();
+}
 
-  if ( buf[i]!='$' &&  buf[i]!='!' ) return result; // Invalid message
-  Prefix=buf[i];
-  i++; // Pass start prefix
+//*****************************************************************************
+size_t tNMEA0183Msg::ImageLen() const {
+  if ( _FieldCount>0 ) return Fields[_FieldCount-1]+strlen(Data+Fields[_FieldCount-1])+1;
+  return 3+strlen(Data+3)+1;
+}
 
-//  Serial.println(buf);
-  // Set sender
-  for (; iData<2 && buf[i]!=0; i++, iData++) {
-    CheckSum^=buf[i];
-    Data[iData]=buf[i];
+//*****************************************************************************
+// Only used part of data will be copied. Field positions are same on both.
+bool tNMEA0183Msg::CopyFrom(const tNMEA0183Msg &NMEA0183Msg) {
+  if ( &NMEA0183Msg==this ) return true;
+
+  size_t len=NMEA0183Msg.ImageLen();
+  if ( len>DataSize || NMEA0183Msg._FieldCount>MaxFields ) {
+    Clear();
+    return false;
   }
 
-  if (buf[i]==0) { Clear(); return result; } // Invalid message
+  memcpy(Data,NMEA0183Msg.Data,len);
+  memcpy(Fields,NMEA0183Msg.Fields,NMEA0183Msg._FieldCount);
+  _MessageTime=NMEA0183Msg._MessageTime;
+  iAddData=NMEA0183Msg.iAddData;
+  Prefix=NMEA0183Msg.Prefix;
+  _FieldCount=NMEA0183Msg._FieldCount;
+  CheckSum=NMEA0183Msg.CheckSum;
+  CodeId=NMEA0183Msg.CodeId;
+  _SenderId=NMEA0183Msg._SenderId;
+  SourceID=NMEA0183Msg.SourceID;
 
-  Data[iData]=0; iData++; // null termination for sender
-  // Set message code. Read until next comma
-  for (; buf[i]!=',' && buf[i]!=0 && iData<MAX_NMEA0183_MSG_LEN; i++, iData++) {
-    CheckSum^=buf[i];
-    Data[iData]=buf[i];
-  }
-  if (buf[i]!=',') { Clear(); return result; } // No separation after message code -> invalid message
-
-  // Set the data and calculate checksum. Read until '*'
-  for (; buf[i]!='*' && buf[i]!=0 && iData<MAX_NMEA0183_MSG_LEN; i++, iData++) {
-    CheckSum^=buf[i];
-    Data[iData]=buf[i];
-    if (buf[i]==',') { // New field
-      Data[iData]=0; // null termination for previous field
-      Fields[_FieldCount]=iData+1;   // Set start of field
+  return true;
+}
+
+//*****************************************************************************
+bool tNMEA0183Msg::SetMessage(const char *buf) {
+  return SetMessage(buf,(buf!=0?strlen(buf):0));
+}
+
+//*****************************************************************************
+// Message is handled in one pass. Sender goes to Data[0..1] and from message
+// code on buf[i] goes to Data[i], so blocks can be copied as they are.
+bool tNMEA0183Msg::SetMessage(const char *buf, size_t len) {
+  Clear();
+  _MessageTime=millis();
+
+  if ( buf==0 || len<7 ) return false; // Shortest message is like $GP,*hh
+  if ( buf[0]!='$' &&  buf[0]!='!' ) return false; // Invalid message
+  Prefix=buf[0];
+
+  // Set sender
+  Data[0]=buf[1]; Data[1]=buf[2]; Data[2]=0;
+
+  // Set message code and data and calculate checksum. Read until '*' a block at time.
+  size_t i=3;
+  uint8_t cs=buf[1]^buf[2];
+  bool CheckSumFound=false;
+  while ( i<len && i<DataSize && !CheckSumFound ) {
+    tNMEA0183ScanMasks Masks;
+    size_t n=len-i;
+    if ( n>NMEA0183_SCAN_BLOCK_LEN ) n=NMEA0183_SCAN_BLOCK_LEN;
+    if ( n>DataSize-i ) n=DataSize-i;
+    NMEA0183ScanBlock(buf+i,n,Masks);
+    uint32_t Commas=Masks.Comma;
+    if ( Masks.CheckSum!=0 ) {
+      n=__builtin_ctz(Masks.CheckSum);
+      Commas&=((uint32_t)1<<n)-1;
+      CheckSumFound=true;
+    }
+    memcpy(Data+i,buf+i,n);
+    cs=NMEA0183XorBytes(buf+i,n,cs);
+    for ( ; Commas!=0; Commas&=Commas-1 ) { // New field. First comma ends message code.
+      uint8_t iComma=i+__builtin_ctz(Commas);
+      if ( _FieldCount>=MaxFields ) { Clear(); return false; } // Too many fields
+      Data[iComma]=0; // null termination for previous field
+      Fields[_FieldCount]=iComma+1;   // Set start of field
       _FieldCount++;
     }
+    i+=n;
   }
 
-  if (buf[i]!='*') { Clear(); return false; } // No checksum -> invalid message
-  Data[iData]=0; // null termination for previous field
-  i++; // Pass '*';
-  csMsg=(buf[i]<=57?buf[i]-48:buf[i]-55)<<4; i++;
-  csMsg|=(buf[i]<=57?buf[i]-48:buf[i]-55);
+  // Message must have checksum with two digits and separator after message code.
+  if ( !CheckSumFound || i>=DataSize || i+3>len || _FieldCount==0 ) { Clear(); return false; }
+  Data[i]=0; // null termination for last field
 
-  if (csMsg==CheckSum) {
-    result=true;
-  } else {
-    Clear();
+  if ( NMEA0183HexByte(buf+i+1)!=cs ) { Clear(); return false; }
+  CheckSum=cs;
+  _SenderId=NMEA0183SenderId(Data);
+  CodeId=NMEA0183MsgCodeId(Data+3,Fields[0]-1-3);
+
+  return true;
+}
+
+//*****************************************************************************
+bool tNMEA0183Msg::SetImage(const char *_Image, size_t len, char _Prefix, uint8_t _CheckSum, unsigned long MsgTime) {
+  Clear();
+
+  if ( _Image==0 || len<5 || len>DataSize || _Image[2]!=0 || _Image[len-1]!=0 ) return false;
+
+  memcpy(Data,_Image,len);
+  const char *End=Data+len;
+  const char *p=(const char *)memchr(Data+3,0,len-3); // End of message code
+  uint8_t CodeLen=p-(Data+3);
+  // Image ends to null, so there is always next null.
+  for ( p++; p<End; p=(const char *)memchr(p,0,End-p)+1 ) {
+    if ( _FieldCount>=MaxFields ) { Clear(); return false; } // Too many fields
+    Fields[_FieldCount]=p-Data;
+    _FieldCount++;
   }
 
-  return result;
+  iAddData=len;
+  Prefix=_Prefix;
+  CheckSum=_CheckSum;
+  _MessageTime=MsgTime;
+  _SenderId=NMEA0183SenderId(Data);
+  CodeId=NMEA0183MsgCodeId(Data+3,CodeLen);
+
+  return true;
 }
 
 //*****************************************************************************
@@ -144,7 +228,9 @@ bool tNMEA0183Msg::GetMessage(char *MsgData, size_t BufSize) const {
   }
 
   if ( BufSize<5 ) return false; // Is there room for termination *xx0
-  sprintf(MsgData,"*%02X",GetCheckSum());
+  MsgData[0]='*';
+  NMEA0183FormatHexByte(MsgData+1,GetCheckSum());
+  MsgData[3]=0;
   return true;
 }
 
@@ -168,6 +254,8 @@ bool tNMEA0183Msg::Init(const char *_MessageCode, const char *_Sender, char _Pre
   Data[2]=0;
   strcpy((Data+3),_MessageCode);
   iAddData=3+nMessageCode+1;
+  _SenderId=NMEA0183SenderId(Data);
+  CodeId=NMEA0183MsgCodeId(Data+3,nMessageCode);
 
   for ( int i=3; Data[i]!=0; i++ ) CheckSum^=Data[i];
 
@@ -176,8 +264,8 @@ bool tNMEA0183Msg::Init(const char *_MessageCode, const char *_Sender, char _Pre
 
 //*****************************************************************************
 bool tNMEA0183Msg::AddEmptyField() {
-  if ( iAddData>=MAX_NMEA0183_MSG_LEN ||
-       _FieldCount>=MAX_NMEA0183_MSG_FIELDS ) return false; // Is there room for any data
+  if ( iAddData>=DataSize ||
+       _FieldCount>=MaxFields ) return false; // Is there room for any data
 
   Data[iAddData]=0;
   CheckSum^=',';
@@ -190,8 +278,8 @@ bool tNMEA0183Msg::AddEmptyField() {
 
 //*****************************************************************************
 bool tNMEA0183Msg::AddStrField(const char *FieldData) {
-  if ( iAddData>=MAX_NMEA0183_MSG_LEN ||
-       _FieldCount>=MAX_NMEA0183_MSG_FIELDS ) return false; // Is there room for any data
+  if ( iAddData>=DataSize ||
+       _FieldCount>=MaxFields ) return false; // Is there room for any data
 
   int i=0;
   uint8_t cs=CheckSum;
@@ -201,7 +289,7 @@ bool tNMEA0183Msg::AddStrField(const char *FieldData) {
   cs^=',';
   Fields[_FieldCount]=iAdd;   // Set start of field
   if ( FieldData!=0 ) {
-    for (;iAdd<MAX_NMEA0183_MSG_LEN-1 && FieldData[i]!=0; i++,iAdd++) {
+    for (;iAdd<DataSize-1 && FieldData[i]!=0; i++,iAdd++) {
       Data[iAdd]=FieldData[i];
       cs^=FieldData[i];
     }
@@ -216,82 +304,43 @@ bool tNMEA0183Msg::AddStrField(const char *FieldData) {
 }
 
 //*****************************************************************************
-bool tNMEA0183Msg::AddUInt32Field(uint32_t val) {
-  if ( val==NMEA0183UInt32NA ) return AddEmptyField();
-
-  if ( iAddData>=MAX_NMEA0183_MSG_LEN ||
-       _FieldCount>=MAX_NMEA0183_MSG_FIELDS ) return false; // Is there room for any data
-
-  int needSize;
-  uint8_t cs=CheckSum;
+// Number has been formatted to Data+iAddData by caller. len 0 means that it did not fit.
+bool tNMEA0183Msg::CommitNumField(size_t len) {
+  if ( len==0 ) {
+    ForceNullTermination();
+    return false;
+  }
 
-  cs^=',';
+  CheckSum=NMEA0183XorBytes(Data+iAddData,len,CheckSum^',');
   Fields[_FieldCount]=iAddData;   // Set start of field
-  needSize=snprintf((Data+iAddData),MAX_NMEA0183_MSG_LEN-iAddData,"%lu",(unsigned long)val);
-  ForceNullTermination();
+  iAddData+=len+1;
+  _FieldCount++;
 
-  if ( needSize>MAX_NMEA0183_MSG_LEN-1-iAddData ) return false;
+  return true;
+}
 
-  for ( int i=iAddData; Data[i]!=0; i++ ) cs^=Data[i];
-  iAddData+=needSize+1;
+//*****************************************************************************
+bool tNMEA0183Msg::AddUInt32Field(uint32_t val, uint8_t Width) {
+  if ( val==NMEA0183UInt32NA ) return AddEmptyField();
 
-  _FieldCount++;
-  CheckSum=cs;
-  return true;
+  if ( iAddData>=DataSize ||
+       _FieldCount>=MaxFields ) return false; // Is there room for any data
+
+  return CommitNumField(NMEA0183FormatUInt32(Data+iAddData,DataSize-iAddData,val,Width));
 }
 
 //*****************************************************************************
-bool tNMEA0183Msg::AddDoubleField(double val, double multiplier, const char *Format, const char *Unit) {
+bool tNMEA0183Msg::AddDoubleField(double val, double multiplier, const tNMEA0183NumFormat &Format, const char *Unit) {
   if ( NMEA0183IsNA(val) ) {
     bool ret=AddEmptyField();
     if ( Unit!=0 ) ret=AddStrField(Unit);
     return ret;
   }
 
-  if ( iAddData>=MAX_NMEA0183_MSG_LEN ||
-       _FieldCount>=MAX_NMEA0183_MSG_FIELDS ) return false; // Is there room for any data
+  if ( iAddData>=DataSize ||
+       _FieldCount>=MaxFields ) return false; // Is there room for any data
 
-  int needSize;
-  uint8_t cs=CheckSum;
-
-  cs^=',';
-  Fields[_FieldCount]=iAddData;   // Set start of field
-  #ifndef NO_PRINTF_DOUBLE_SUPPORT
-  needSize=snprintf((Data+iAddData),MAX_NMEA0183_MSG_LEN-iAddData,Format,val*multiplier);
-  ForceNullTermination();
-  #else
-  char StrVal[20];
-  uint8_t precision=0;
-  uint8_t width=1;
-  bool Padding=false;
-  // Try to solve requested width and precision
-  char *DotPos=strchr(Format,'.');
-  if ( DotPos!=0 ) {
-    char *PrecPos=DotPos+1;
-    if ( PrecPos!=0 ) precision=atoi(PrecPos);
-    char *WidthPos=DotPos;
-    while (WidthPos>Format && (*(WidthPos-1))!='%' ) WidthPos--;
-    if ( WidthPos!=DotPos ) {
-      width=atoi(WidthPos);
-      if ( *WidthPos=='0' ) Padding=true;
-    }
-  }
-  // Convert to string.
-  dtostrf(val*multiplier, width, precision, StrVal);
-  needSize=strlen(StrVal);
-  if ( needSize<MAX_NMEA0183_MSG_LEN-iAddData ) {
-    if ( Padding ) for ( char *s=StrVal; *s==' '; *s='0', s++);
-    strcpy((Data+iAddData),StrVal);
-  }
-  #endif
-
-  if ( needSize>MAX_NMEA0183_MSG_LEN-1-iAddData ) return false;
-
-  for ( int i=iAddData; Data[i]!=0; i++ ) cs^=Data[i];
-  iAddData+=needSize+1;
-
-  _FieldCount++;
-  CheckSum=cs;
+  if ( !CommitNumField(NMEA0183FormatDouble(Data+iAddData,DataSize-iAddData,val*multiplier,Format)) ) return false;
 
   if ( Unit!=0 ) return AddStrField(Unit);
 
@@ -299,23 +348,33 @@ bool tNMEA0183Msg::AddDoubleField(double val, double multiplier, const char *For
 }
 
 //*****************************************************************************
-bool tNMEA0183Msg::AddTimeField(double GPSTime, const char *Format) {
+bool tNMEA0183Msg::AddDoubleField(double val, double multiplier, const char *Format, const char *Unit) {
+  return AddDoubleField(val,multiplier,NMEA0183NumFormat(Format),Unit);
+}
+
+//*****************************************************************************
+bool tNMEA0183Msg::AddTimeField(double GPSTime, const tNMEA0183NumFormat &Format) {
   return AddDoubleField(GPSTimeToNMEA0183Time(GPSTime),1,Format);
 }
 
+//*****************************************************************************
+bool tNMEA0183Msg::AddTimeField(double GPSTime, const char *Format) {
+  return AddTimeField(GPSTime,NMEA0183NumFormat(Format));
+}
+
 //*****************************************************************************
 bool tNMEA0183Msg::AddDaysField(unsigned long DaysSince1970) {
   if ( DaysSince1970==NMEA0183UInt32NA  ) return AddEmptyField();
 
-  return AddDoubleField(DaysToNMEA0183Date(DaysSince1970),1,"%06.0f");
+  return AddUInt32Field(DaysToNMEA0183Date(DaysSince1970),6);
 }
 
 //*****************************************************************************
-bool tNMEA0183Msg::AddLatitudeField(double Latitude, const char *Format) {
+bool tNMEA0183Msg::AddLatitudeField(double Latitude, const tNMEA0183NumFormat &Format) {
   if ( Latitude==NMEA0183DoubleNA ) return AddEmptyField() & AddEmptyField();
 
-  if ( iAddData>=MAX_NMEA0183_MSG_LEN-8 ||
-       _FieldCount>=MAX_NMEA0183_MSG_FIELDS-1 ) return false; // Is there room for any data
+  if ( iAddData>=DataSize-8 ||
+       _FieldCount>=MaxFields-1 ) return false; // Is there room for any data
 
   if ( ! AddDoubleField(DoubleToddmm((Latitude>=0?Latitude:-Latitude)),1,Format) ) return false; // abs generated -0.00 for 0.00??
 
@@ -325,11 +384,16 @@ bool tNMEA0183Msg::AddLatitudeField(double Latitude, const char *Format) {
 }
 
 //*****************************************************************************
-bool tNMEA0183Msg::AddLongitudeField(double Longitude, const char *Format) {
+bool tNMEA0183Msg::AddLatitudeField(double Latitude, const char *Format) {
+  return AddLatitudeField(Latitude,NMEA0183NumFormat(Format));
+}
+
+//*****************************************************************************
+bool tNMEA0183Msg::AddLongitudeField(double Longitude, const tNMEA0183NumFormat &Format) {
   if ( Longitude==NMEA0183DoubleNA ) return AddEmptyField() & AddEmptyField();
 
-  if ( iAddData>=MAX_NMEA0183_MSG_LEN-8 ||
-       _FieldCount>=MAX_NMEA0183_MSG_FIELDS-1 ) return false; // Is there room for any data
+  if ( iAddData>=DataSize-8 ||
+       _FieldCount>=MaxFields-1 ) return false; // Is there room for any data
 
   if ( ! AddDoubleField(DoubleToddmm((Longitude>=0?Longitude:-Longitude)),1,Format) ) return false; // abs generated -0.00 for 0.00??
 
@@ -339,16 +403,75 @@ bool tNMEA0183Msg::AddLongitudeField(double Longitude, const char *Format) {
 }
 
 
+//*****************************************************************************
+bool tNMEA0183Msg::AddLongitudeField(double Longitude, const char *Format) {
+  return AddLongitudeField(Longitude,NMEA0183NumFormat(Format));
+}
+
+//*****************************************************************************
+bool tNMEA0183Msg::AddFixedField(int32_t val, uint8_t Decimals, const char *Unit, uint8_t Width) {
+  bool ret;
+
+  if ( val==NMEA0183Int32NA ) {
+    ret=AddEmptyField();
+  } else {
+    if ( iAddData>=DataSize ||
+         _FieldCount>=MaxFields ) return false; // Is there room for any data
+    ret=CommitNumField(NMEA0183FormatFixed(Data+iAddData,DataSize-iAddData,val,Decimals,Width));
+    if ( !ret ) return false;
+  }
+
+  if ( Unit!=0 ) ret=AddStrField(Unit);
+
+  return ret;
+}
+
+//*****************************************************************************
+bool tNMEA0183Msg::AddTimeFieldMs(uint32_t MilliSeconds) {
+  if ( MilliSeconds==NMEA0183UInt32NA ) return AddEmptyField();
+
+  uint32_t cs=((MilliSeconds+5)/10)%(24UL*3600UL*100UL); // Centiseconds, wraps at midnight
+  uint32_t s=cs/100;
+  uint32_t hhmmss=(s/3600)*10000UL+((s/60)%60)*100UL+s%60;
+
+  return AddFixedField((int32_t)(hhmmss*100UL+cs%100),2,0,9);
+}
+
+//*****************************************************************************
+bool tNMEA0183Msg::AddLatLonFieldE7(int32_t val, uint8_t DegDigits, uint8_t Decimals, const char *Positive, const char *Negative) {
+  if ( val==NMEA0183Int32NA ) return AddEmptyField() & AddEmptyField();
+
+  if ( iAddData>=DataSize-8 ||
+       _FieldCount>=MaxFields-1 ) return false; // Is there room for any data
+
+  if ( !CommitNumField(NMEA0183FormatLatLonE7(Data+iAddData,DataSize-iAddData,val,DegDigits,Decimals)) ) return false;
+
+  return AddStrField(val>=0?Positive:Negative);
+}
+
+//*****************************************************************************
+bool tNMEA0183Msg::AddLatitudeFieldE7(int32_t Latitude, uint8_t Decimals) {
+  return AddLatLonFieldE7(Latitude,2,Decimals,"N","S");
+}
+
+//*****************************************************************************
+bool tNMEA0183Msg::AddLongitudeFieldE7(int32_t Longitude, uint8_t Decimals) {
+  return AddLatLonFieldE7(Longitude,3,Decimals,"E","W");
+}
+
 //*****************************************************************************
 void tNMEA0183Msg::Clear() {
   SourceID=0;
   Data[0]=0;  // Sender is empty
-  Data[2]=0;  // Message code is empty
+  Data[2]=0;
+  Data[3]=0;  // Message code is empty
   iAddData=0;
   _FieldCount=0;
   Fields[0]=0;
   _MessageTime=0;
   CheckSum=0;
+  CodeId=0;
+  _SenderId=0;
   Prefix=' ';
 }
 
@@ -366,11 +489,9 @@ void tNMEA0183Msg::Send(tNMEA0183Stream &port) const {
     port.print(",");
     port.print(Field(i));
   }
-//  port.print("*");
-  char buf[7];
-  sprintf(buf,"*%02X\r\n",CheckSum);
+  char buf[6]="*hh\r\n";
+  NMEA0183FormatHexByte(buf+1,CheckSum);
   port.print(buf);
-  port.print("\r\n");
 }
 
 //*****************************************************************************
@@ -419,8 +540,6 @@ double tNMEA0183Msg::DoubleToddmm(double val) {
   return val;
 }
 
-unsigned long tNMEA0183Msg::TimeTDaysTo1970Offset=tNMEA0183Msg::CalcTimeTDaysTo1970Offset();
-
 //*****************************************************************************
 unsigned long tNMEA0183Msg::elapsedDaysSince1970(time_t dt) {
   unsigned long days=dt/SECS_PER_DAY;
@@ -433,40 +552,45 @@ unsigned long tNMEA0183Msg::elapsedDaysSince1970(time_t dt) {
 
 #ifndef _Time_h
 //*****************************************************************************
-time_t tNMEA0183Msg::daysToTime_t(unsigned long val) {
-  val-=TimeTDaysTo1970Offset;
+time_t tNMEA0183Msg::makeTime(tmElements_t &TimeElements) {
+  int32_t Days=NMEA0183DaysFromCivil(GetYear(TimeElements),GetMonth(TimeElements),GetDay(TimeElements));
+  Days-=(int32_t)TimeTDaysTo1970Offset;
 
-  return val*SECS_PER_DAY;
+  return (time_t)Days*86400L+TimeElements.tm_hour*3600L+TimeElements.tm_min*60L+TimeElements.tm_sec;
 }
-#endif
 
 //*****************************************************************************
-unsigned long tNMEA0183Msg::CalcTimeTDaysTo1970Offset() {
-  // Need better routine. Now just guess between 1.1.1970 and 1.1.2000
-  tmElements_t tme;
-  SetYear(tme,2010);
-  SetMonth(tme,1);
-  SetDay(tme,1);
-  SetHour(tme,0);
-  SetMin(tme,0);
-  SetSec(tme,0);
+void tNMEA0183Msg::breakTime(time_t time, tmElements_t &TimeElements) {
+  int32_t Days=(int32_t)(time/86400L);
+  int32_t Seconds=(int32_t)(time-(time_t)Days*86400L);
+  if ( Seconds<0 ) { Seconds+=86400L; Days--; }
+  Days+=(int32_t)TimeTDaysTo1970Offset;
+  tNMEA0183Date Date=NMEA0183CivilFromDays(Days);
+
+  memset(&TimeElements,0,sizeof(TimeElements));
+  SetYear(TimeElements,Date.Year);
+  SetMonth(TimeElements,Date.Month);
+  SetDay(TimeElements,Date.Day);
+  SetHour(TimeElements,Seconds/3600);
+  SetMin(TimeElements,(Seconds/60)%60);
+  SetSec(TimeElements,Seconds%60);
+  TimeElements.tm_wday=(Days%7+11)%7; // 1.1.1970 was Thursday
+  TimeElements.tm_yday=Days-NMEA0183DaysFromCivil(Date.Year,1,1);
+}
 
-  unsigned long days=makeTime(tme)/SECS_PER_DAY;
+//*****************************************************************************
+time_t tNMEA0183Msg::daysToTime_t(unsigned long val) {
+  val-=TimeTDaysTo1970Offset;
 
-  return 14610-days;
+  return val*SECS_PER_DAY;
 }
+#endif
 
 //*****************************************************************************
 unsigned long tNMEA0183Msg::DaysToNMEA0183Date(unsigned long val) {
   if ( val!=NMEA0183UInt32NA  ) {
-    tmElements_t tm;
-    #ifndef _Time_h
-    time_t t=daysToTime_t(val);
-    #else
-    time_t t=val*86400;
-    #endif
-    breakTime(t, tm);
-    val=(unsigned long)GetDay(tm)*10000+(unsigned long)GetMonth(tm)*100+((unsigned long)GetYear(tm)-2000);
+    tNMEA0183Date Date=NMEA0183CivilFromDays((int32_t)val);
+    val=(unsigned long)Date.Day*10000+(unsigned long)Date.Month*100+((unsigned long)Date.Year-2000);
   }
 
   return val;
@@ -28,6 +28,9 @@ OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <string.h>
 #include <time.h>
 #include "NMEA0183Stream.h"
+#include "NMEA0183FieldFormatter.h"
+#include "NMEA0183FieldParser.h"
+#include "NMEA0183Calendar.h"
 
 const double   NMEA0183DoubleNA=-1e9;
 const uint8_t  NMEA0183UInt8NA=0xff;
@@ -52,25 +55,63 @@ inline bool NMEA0183IsNA(int32_t v) { return v==NMEA0183Int32NA; }
 typedef tm tmElements_t;
 #endif
 
+// Days from time_t epoch to 1.1.1970. avr-libc time_t starts from 1.1.2000.
+#if !defined(_Time_h) && defined(UNIX_OFFSET)
+#define NMEA0183_TIME_T_DAYS_TO_1970 (UNIX_OFFSET/86400UL)
+#else
+#define NMEA0183_TIME_T_DAYS_TO_1970 0
+#endif
+
+// Packed ids for message codes and senders. Each character in range '!'..'_' is
+// packed to 6 bits, so message code of max 5 characters fits to uint32_t and
+// sender to uint16_t. Id is 0 for empty or not packable code. Ids can be calculated
+// at compile time, so e.g. switch ( Msg.MessageCodeId() ) { case NMEA0183MsgCodeId("RMC"): ... }
+// works.
+#define NMEA0183_MAX_CODE_ID_LEN 5
+#define NMEA0183_NOT_PACKABLE_ID 0x80000000UL
+
+constexpr uint32_t NMEA0183IdChar(char c) { return ( c>0x20 && c<0x60 ? c-0x20 : 0 ); }
+constexpr uint32_t NMEA0183PackId(const char *code, uint8_t i) {
+  return ( code[i]==0 ? 0
+           : ( i>=NMEA0183_MAX_CODE_ID_LEN || NMEA0183IdChar(code[i])==0 ? NMEA0183_NOT_PACKABLE_ID
+               : (NMEA0183IdChar(code[i])<<(6*i)) | NMEA0183PackId(code,i+1) ) );
+}
+constexpr uint32_t NMEA0183MsgCodeId(const char *code) {
+  return ( code==0 || (NMEA0183PackId(code,0) & NMEA0183_NOT_PACKABLE_ID)!=0 ? 0 : NMEA0183PackId(code,0) );
+}
+constexpr uint16_t NMEA0183SenderId(const char *sender) {
+  return ( sender==0 || NMEA0183IdChar(sender[0])==0 || NMEA0183IdChar(sender[1])==0 ? 0
+           : NMEA0183IdChar(sender[0]) | (NMEA0183IdChar(sender[1])<<6) );
+}
+constexpr uint64_t NMEA0183MsgId(uint16_t SenderId, uint32_t CodeId) { return ((uint64_t)SenderId<<32) | CodeId; }
+// Run time versions for not null terminated data.
+uint32_t NMEA0183MsgCodeId(const char *code, size_t len);
+
 //------------------------------------------------------------------------------
 class tNMEA0183Msg
 {
   protected:
     static const char *EmptyField;
     unsigned long _MessageTime;
-    char Data[MAX_NMEA0183_MSG_LEN];
+    char *Data;          // DefaultData or storage of tNMEA0183MsgT
+    uint8_t *Fields;     // DefaultFields or storage of tNMEA0183MsgT
+    uint8_t DataSize;    // Capacity of Data
+    uint8_t MaxFields;   // Capacity of Fields
     uint8_t iAddData;
     char Prefix;
-    uint8_t Fields[MAX_NMEA0183_MSG_FIELDS];
     uint8_t _FieldCount;
     uint8_t CheckSum;
-
+    uint32_t CodeId;
+    uint16_t _SenderId;
+    char DefaultData[MAX_NMEA0183_MSG_LEN];
+    uint8_t DefaultFields[MAX_NMEA0183_MSG_FIELDS];
 
 // Helper functions on converting TimeLib.h to time.h
   protected:
-    static unsigned long TimeTDaysTo1970Offset; // Offset for time_t to 1.1.1970. Seem to vary betweel libraries.
-    static unsigned long CalcTimeTDaysTo1970Offset();
+    static constexpr unsigned long TimeTDaysTo1970Offset=NMEA0183_TIME_T_DAYS_TO_1970; // Offset for time_t to 1.1.1970.
     bool AddToBuf(const char *data, char * &buf, size_t &BufSize) const;
+    bool CommitNumField(size_t len);
+    bool AddLatLonFieldE7(int32_t val, uint8_t DegDigits, uint8_t Decimals, const char *Positive, const char *Negative);
 
   public:
     #ifdef _Time_h
@@ -95,14 +136,17 @@ class tNMEA0183Msg
     static inline int GetYear(const tmElements_t &TimeElements) { return TimeElements.tm_year+1900; }
     static inline int GetMonth(const tmElements_t &TimeElements) { return TimeElements.tm_mon+1; }
     static inline int GetDay(const tmElements_t &TimeElements) { return TimeElements.tm_mday; }
-    static inline time_t makeTime(tmElements_t &TimeElements) { return mktime(&TimeElements); }
-    static inline void breakTime(time_t time, tmElements_t &TimeElements) { TimeElements=*localtime(&time); }
+    // Time elements are in UTC. These do not use mktime or localtime, so result does not depend on time zone.
+    static time_t makeTime(tmElements_t &TimeElements);
+    static void breakTime(time_t time, tmElements_t &TimeElements);
     static time_t daysToTime_t(unsigned long val);
     #endif
     static unsigned long elapsedDaysSince1970(time_t dt);
 
   protected:
-    void ForceNullTermination() { Data[MAX_NMEA0183_MSG_LEN-1]=0; } // Just force null termination for data
+    void ForceNullTermination() { Data[DataSize-1]=0; } // Just force null termination for data
+    // Set storage for message. Used by tNMEA0183MsgT. Message will be cleared.
+    void SetStorage(char *_Data, uint8_t _DataSize, uint8_t *_Fields, uint8_t _MaxFields);
 
   public:
     uint8_t SourceID;  // This is used to separate messages e.g. from different ports. Receiver must set this.
@@ -110,10 +154,28 @@ class tNMEA0183Msg
 
   public:
     tNMEA0183Msg();
+    // Copies keep their own storage. If message does not fit to target capacity,
+    // target will be cleared.
+    tNMEA0183Msg(const tNMEA0183Msg &NMEA0183Msg);
+    tNMEA0183Msg &operator=(const tNMEA0183Msg &NMEA0183Msg);
+    // Copy message. Returns false and clears message, if NMEA0183Msg does not fit.
+    bool CopyFrom(const tNMEA0183Msg &NMEA0183Msg);
+    // Max length of message data and max count of fields.
+    uint8_t Capacity() const { return DataSize; }
+    uint8_t FieldCapacity() const { return MaxFields; }
     // Set message from received null terminated buffer. Returns true if checksum is OK.
     bool SetMessage(const char *buf);
+    // Set message from received buffer with length len. Characters after checksum are ignored.
+    bool SetMessage(const char *buf, size_t len);
     // Get message as complete NMEA0183 format string to buffer.
     bool GetMessage(char *MsgData, size_t BufSize) const;
+    // Data image of message: sender, message code and fields each terminated with null,
+    // e.g. "GP\0HDT\0244.71\0T\0". Image can be stored compactly and set back with SetImage.
+    const char *Image() const { return Data; }
+    size_t ImageLen() const;
+    // Set message from data image. Field positions will be rebuilt from null terminations.
+    // Returns false, if image is invalid or does not fit.
+    bool SetImage(const char *_Image, size_t len, char _Prefix, uint8_t _CheckSum, unsigned long MsgTime);
     // Clear message
     void Clear();
     // Print message fields
@@ -131,12 +193,33 @@ class tNMEA0183Msg
     const char *MessageCode() const { return Data+3; }
     // Return checksum of message.
     uint8_t GetCheckSum() const { return CheckSum; }
-    // Check is message code given
-    bool IsMessageCode(const char* _code) const { return (strcmp(MessageCode(),_code)==0); }
+    // Return packed ids of sender and message code. See NMEA0183MsgCodeId.
+    uint16_t SenderId() const { return _SenderId; }
+    uint32_t MessageCodeId() const { return CodeId; }
+    uint64_t MessageId() const { return NMEA0183MsgId(_SenderId,CodeId); }
+    // Check is message code given. For packable literal code this is integer compare.
+    bool IsMessageCode(const char* _code) const {
+      return ( NMEA0183MsgCodeId(_code)!=0 ? NMEA0183MsgCodeId(_code)==CodeId : strcmp(MessageCode(),_code)==0 );
+    }
+    bool IsMessageCodeId(uint32_t _CodeId) const { return _CodeId!=0 && _CodeId==CodeId; }
     //
     unsigned long MessageTime() const { return _MessageTime; }
     // Return length of field
     unsigned int FieldLen(uint8_t index) const;
+    // Typed field accessors. Empty or invalid field returns NA. Get supports double and int32_t.
+    // E.g. double SOG=Msg.Get<double>(6); Accessors do not change message, so shared message
+    // can be read from several threads. Use tNMEA0183CachedFields to parse each field only once.
+    template <typename T> T Get(uint8_t index) const;
+    // Latitude or longitude in degrees. Sign field ('S' or 'W' is negative) is on SignIndex.
+    double GetLatLon(uint8_t index, uint8_t SignIndex) const {
+      double val;
+      return ( NMEA0183FieldToLatLon(Field(index),FieldLen(index),Field(SignIndex)[0],val)?val:NMEA0183DoubleNA );
+    }
+    // Time in seconds since midnight from hhmmss.ss field.
+    double GetTime(uint8_t index) const {
+      double val;
+      return ( NMEA0183FieldToSeconds(Field(index),FieldLen(index),val)?val:NMEA0183DoubleNA );
+    }
 
     // Init message building.
     bool Init(const char *_MessageCode, const char *_Sender="II", char _Prefix='$');
@@ -147,8 +230,8 @@ class tNMEA0183Msg
     // Add string field. E.g. AddStrField("K") causes ,K, on final message.
     bool AddStrField(const char *FieldData);
 
-    //
-    bool AddUInt32Field(uint32_t val);
+    // Add unsigned integer field padded with zeros to Width.
+    bool AddUInt32Field(uint32_t val, uint8_t Width=0);
 
     // Add double field. val must be in SI units (as in NMEA2000). Provide multiplier for conversion and
     // Format (default %.1f), if necessary. If you also provide Unit, it will be added as own field.
@@ -156,21 +239,40 @@ class tNMEA0183Msg
     // Examples:
     // NMEA0183Msg.AddDoubleField(120.123,radToDeg,tNMEA0183Msg::DefDoubleFormat,"M"); -> ,120.1,M
     // NMEA0183Msg.AddDoubleField(23.123); -> ,23.1
+    // NMEA0183Msg.AddDoubleField(23.123,1,tNMEA0183NumFormat(2,6)); -> ,023.12
+    bool AddDoubleField(double val, double multiplier, const tNMEA0183NumFormat &Format, const char *Unit=0);
+    // Format is printf format like "%.1f" or "%09.2f". Only width and precision will be used.
     bool AddDoubleField(double val, double multiplier=1, const char *Format=DefDoubleFormat, const char *Unit=0);
 
     // Add time field. GPSTime is just seconds since midnight.
-    bool AddTimeField(double GPSTime, const char *Format="%09.2f");
+    bool AddTimeField(double GPSTime, const tNMEA0183NumFormat &Format=tNMEA0183NumFormat(2,9));
+    bool AddTimeField(double GPSTime, const char *Format);
 
     // Add Days field.
     bool AddDaysField(unsigned long DaysSince1970);
 
     // Add Latitude field. Also E/W will be added. Latitude is in degrees. Negative value is W. E.g.
     // AddLatitudeField(-5.2345); -> ,5.235,W
-    bool AddLatitudeField(double Latitude, const char *Format="%.3f");
+    bool AddLatitudeField(double Latitude, const tNMEA0183NumFormat &Format=tNMEA0183NumFormat(3));
+    bool AddLatitudeField(double Latitude, const char *Format);
 
     // Add Longitude field. Also N/S will be added. Longitude is in degrees. Negative value is S. E.g.
     // AddLongitudeField(-5.2345); -> ,514.070,S
-    bool AddLongitudeField(double Longitude, const char *Format="%.3f");
+    bool AddLongitudeField(double Longitude, const tNMEA0183NumFormat &Format=tNMEA0183NumFormat(3));
+    bool AddLongitudeField(double Longitude, const char *Format);
+
+    // Fixed point versions of field functions above. These do not use floating point at all.
+    // Add fixed point value val/10^Decimals. NMEA0183Int32NA adds empty field. E.g.
+    // AddFixedField(-12345,3,"M"); -> ,-12.345,M
+    bool AddFixedField(int32_t val, uint8_t Decimals, const char *Unit=0, uint8_t Width=0);
+
+    // Add time field. Time is milliseconds since midnight and will be added in hhmmss.ss format.
+    bool AddTimeFieldMs(uint32_t MilliSeconds);
+
+    // Add latitude or longitude given in 1e-7 degrees. Degrees will be padded with zeros as
+    // required by NMEA0183. E.g. AddLatitudeFieldE7(-52345000); -> ,0514.0700,S
+    bool AddLatitudeFieldE7(int32_t Latitude, uint8_t Decimals=4);
+    bool AddLongitudeFieldE7(int32_t Longitude, uint8_t Decimals=4);
 
     // Helper function to convert GPSTime to NMEA0183 time (hhmmss.sss). E.g. 42000.55 -> 114000.55
     static double GPSTimeToNMEA0183Time(double GPSTime);
@@ -182,4 +284,44 @@ class tNMEA0183Msg
     static unsigned long DaysToNMEA0183Date(unsigned long val);
 };
 
+//*****************************************************************************
+template <> inline double tNMEA0183Msg::Get<double>(uint8_t index) const {
+  double val;
+  return ( NMEA0183FieldToDouble(Field(index),FieldLen(index),val)?val:NMEA0183DoubleNA );
+}
+
+//*****************************************************************************
+template <> inline int32_t tNMEA0183Msg::Get<int32_t>(uint8_t index) const {
+  int32_t val;
+  return ( NMEA0183FieldToInt32(Field(index),FieldLen(index),val)?val:NMEA0183Int32NA );
+}
+
+//------------------------------------------------------------------------------
+// Message with compile time capacity. Use this for proprietary sentences longer
+// than MAX_NMEA0183_MSG_LEN or e.g. XDR with more than MAX_NMEA0183_MSG_FIELDS
+// fields. Len includes null termination as MAX_NMEA0183_MSG_LEN. Own storage
+// will be reserved only when default storage of tNMEA0183Msg is not large enough.
+// E.g. tNMEA0183MsgT<200,40> XDRMsg;
+template <uint8_t Len, uint8_t MaxFieldCount>
+class tNMEA0183MsgT : public tNMEA0183Msg
+{
+  static_assert(Len>=16 && MaxFieldCount>=1,"Too small message capacity");
+
+  protected:
+    char ExtData[Len>MAX_NMEA0183_MSG_LEN?Len:1];
+    uint8_t ExtFields[MaxFieldCount>MAX_NMEA0183_MSG_FIELDS?MaxFieldCount:1];
+
+    void InitStorage() {
+      SetStorage(Len>MAX_NMEA0183_MSG_LEN?ExtData:DefaultData,Len,
+                 MaxFieldCount>MAX_NMEA0183_MSG_FIELDS?ExtFields:DefaultFields,MaxFieldCount);
+    }
+
+  public:
+    tNMEA0183MsgT() { InitStorage(); }
+    tNMEA0183MsgT(const tNMEA0183MsgT &NMEA0183Msg) : tNMEA0183Msg() { InitStorage(); CopyFrom(NMEA0183Msg); }
+    tNMEA0183MsgT(const tNMEA0183Msg &NMEA0183Msg) : tNMEA0183Msg() { InitStorage(); CopyFrom(NMEA0183Msg); }
+    tNMEA0183MsgT &operator=(const tNMEA0183MsgT &NMEA0183Msg) { CopyFrom(NMEA0183Msg); return *this; }
+    tNMEA0183MsgT &operator=(const tNMEA0183Msg &NMEA0183Msg) { CopyFrom(NMEA0183Msg); return *this; }
+};
+
 #endif
@@ -0,0 +1,128 @@
+/*
+NMEA0183MsgPool.cpp
+
+Copyright (c) 2015-2019 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#if !defined(__AVR__)
+
+#include "NMEA0183MsgPool.h"
+
+//*****************************************************************************
+tNMEA0183MsgHandle &tNMEA0183MsgHandle::operator=(const tNMEA0183MsgHandle &Handle) {
+  // Take new reference first, so assigning handle to itself is safe.
+  tNMEA0183MsgPoolSlot *NewSlot=Handle.Slot;
+  if ( NewSlot!=0 ) NewSlot->RefCount.fetch_add(1,std::memory_order_relaxed);
+  Release();
+  Slot=NewSlot;
+
+  return *this;
+}
+
+//*****************************************************************************
+tNMEA0183MsgHandle &tNMEA0183MsgHandle::operator=(tNMEA0183MsgHandle &&Handle) {
+  if ( &Handle!=this ) {
+    Release();
+    Slot=Handle.Slot;
+    Handle.Slot=0;
+  }
+
+  return *this;
+}
+
+//*****************************************************************************
+// Release must make our reads of message visible before slot will be reused,
+// and last holder must see all of them before freeing.
+void tNMEA0183MsgHandle::Release() {
+  if ( Slot==0 ) return;
+
+  if ( Slot->RefCount.fetch_sub(1,std::memory_order_acq_rel)==1 ) Slot->Pool->Free(Slot);
+  Slot=0;
+}
+
+//*****************************************************************************
+tNMEA0183MsgPool::tNMEA0183MsgPool(tNMEA0183MsgPoolSlot *_Slots, uint16_t _SlotCount)
+: Slots(0), SlotCount(0), FreeTop(NoSlot), InUseCount(0), FailedCount(0) {
+  if ( _Slots!=0 ) SetStorage(_Slots,_SlotCount);
+}
+
+//*****************************************************************************
+void tNMEA0183MsgPool::SetStorage(tNMEA0183MsgPoolSlot *_Slots, uint16_t _SlotCount) {
+  Slots=_Slots;
+  SlotCount=( _SlotCount<NoSlot ? _SlotCount : NoSlot-1 );
+  for ( uint16_t i=0; i<SlotCount; i++ ) {
+    Slots[i].RefCount.store(0,std::memory_order_relaxed);
+    Slots[i].Next.store(i+1<SlotCount ? i+1 : NoSlot,std::memory_order_relaxed);
+    Slots[i].Pool=this;
+  }
+  FreeTop.store(SlotCount>0 ? 0 : NoSlot,std::memory_order_release);
+  InUseCount.store(0,std::memory_order_relaxed);
+}
+
+//*****************************************************************************
+tNMEA0183MsgHandle tNMEA0183MsgPool::Alloc() {
+  uint32_t Top=FreeTop.load(std::memory_order_acquire);
+  uint16_t Index;
+
+  // Next may be stale, if other thread took the slot meanwhile, but then tag has
+  // changed and exchange fails.
+  for ( ;; ) {
+    Index=Top & 0xffff;
+    if ( Index==NoSlot ) {
+      FailedCount.fetch_add(1,std::memory_order_relaxed);
+      return tNMEA0183MsgHandle();
+    }
+    uint32_t Next=Slots[Index].Next.load(std::memory_order_relaxed);
+    uint32_t NewTop=((Top+0x10000) & 0xffff0000) | Next;
+    if ( FreeTop.compare_exchange_weak(Top,NewTop,std::memory_order_acquire,std::memory_order_acquire) ) break;
+  }
+
+  tNMEA0183MsgPoolSlot *Slot=&Slots[Index];
+  Slot->RefCount.store(1,std::memory_order_relaxed);
+  Slot->Msg.Clear();
+  InUseCount.fetch_add(1,std::memory_order_relaxed);
+
+  return tNMEA0183MsgHandle(Slot);
+}
+
+//*****************************************************************************
+tNMEA0183MsgHandle tNMEA0183MsgPool::Alloc(const tNMEA0183Msg &NMEA0183Msg) {
+  tNMEA0183MsgHandle Handle=Alloc();
+
+  if ( Handle ) Handle.Slot->Msg=NMEA0183Msg;
+
+  return Handle;
+}
+
+//*****************************************************************************
+void tNMEA0183MsgPool::Free(tNMEA0183MsgPoolSlot *Slot) {
+  uint16_t Index=Slot-Slots;
+  uint32_t Top=FreeTop.load(std::memory_order_relaxed);
+  uint32_t NewTop;
+
+  InUseCount.fetch_sub(1,std::memory_order_relaxed);
+  do {
+    Slot->Next.store(Top & 0xffff,std::memory_order_relaxed);
+    NewTop=((Top+0x10000) & 0xffff0000) | Index;
+  } while ( !FreeTop.compare_exchange_weak(Top,NewTop,std::memory_order_release,std::memory_order_relaxed) );
+}
+
+#endif
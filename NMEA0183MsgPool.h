@@ -0,0 +1,143 @@
+/*
+NMEA0183MsgPool.h
+
+Copyright (c) 2015-2019 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+Fixed size pool of messages with intrusive reference counts. Handle to pooled
+message can be copied to several consumers, queues and threads. Copying a
+handle only increments reference count and the slot returns to pool, when the
+last handle has been released. Free slots are kept on lock-free stack, so
+allocation and release do not use heap or locks.
+
+Pooled message must not be changed, while it is shared. Edit returns writable
+message only for the single holder.
+
+  tNMEA0183MsgPoolT<64> Pool;
+  tNMEA0183SPSCQueue<tNMEA0183MsgHandle,32> LoggerQueue, BridgeQueue;
+
+  tNMEA0183MsgHandle Msg=Pool.Alloc();
+  if ( Msg && NMEA0183.GetMessage(*Msg.Edit()) ) {
+    LoggerQueue.Push(Msg);
+    BridgeQueue.Push(Msg);
+  }
+
+Pool must outlive all handles to it.
+*/
+
+#ifndef _tNMEA0183_MSG_POOL_H_
+#define _tNMEA0183_MSG_POOL_H_
+
+#if !defined(__AVR__)
+
+#include <stdint.h>
+#include <atomic>
+#include "NMEA0183Msg.h"
+
+class tNMEA0183MsgPool;
+
+//------------------------------------------------------------------------------
+struct tNMEA0183MsgPoolSlot {
+  tNMEA0183Msg Msg;
+  std::atomic<uint32_t> RefCount;
+  std::atomic<uint16_t> Next;   // Next free slot, while slot is free
+  tNMEA0183MsgPool *Pool;
+};
+
+//------------------------------------------------------------------------------
+class tNMEA0183MsgHandle
+{
+  friend class tNMEA0183MsgPool;
+
+  protected:
+    tNMEA0183MsgPoolSlot *Slot;
+
+    // Take reference given by pool.
+    explicit tNMEA0183MsgHandle(tNMEA0183MsgPoolSlot *_Slot) : Slot(_Slot) {}
+
+  public:
+    tNMEA0183MsgHandle() : Slot(0) {}
+    tNMEA0183MsgHandle(const tNMEA0183MsgHandle &Handle) : Slot(Handle.Slot) {
+      if ( Slot!=0 ) Slot->RefCount.fetch_add(1,std::memory_order_relaxed);
+    }
+    tNMEA0183MsgHandle(tNMEA0183MsgHandle &&Handle) : Slot(Handle.Slot) { Handle.Slot=0; }
+    ~tNMEA0183MsgHandle() { Release(); }
+    tNMEA0183MsgHandle &operator=(const tNMEA0183MsgHandle &Handle);
+    tNMEA0183MsgHandle &operator=(tNMEA0183MsgHandle &&Handle);
+
+    // Drop reference. Slot returns to pool with last reference.
+    void Release();
+    bool IsValid() const { return Slot!=0; }
+    explicit operator bool() const { return Slot!=0; }
+    const tNMEA0183Msg &operator*() const { return Slot->Msg; }
+    const tNMEA0183Msg *operator->() const { return &Slot->Msg; }
+    // Writable message or 0, if message is shared with other handles.
+    tNMEA0183Msg *Edit() { return ( IsUnique() ? &Slot->Msg : 0 ); }
+    bool IsUnique() const { return Slot!=0 && Slot->RefCount.load(std::memory_order_acquire)==1; }
+    uint32_t RefCount() const { return ( Slot!=0 ? Slot->RefCount.load(std::memory_order_relaxed) : 0 ); }
+};
+
+//------------------------------------------------------------------------------
+class tNMEA0183MsgPool
+{
+  friend class tNMEA0183MsgHandle;
+
+  protected:
+    static const uint16_t NoSlot=0xffff;
+    tNMEA0183MsgPoolSlot *Slots;
+    uint16_t SlotCount;
+    // Free stack top. Low 16 bits are slot index and high 16 bits tag, which changes
+    // on every update to avoid ABA problem.
+    std::atomic<uint32_t> FreeTop;
+    std::atomic<uint16_t> InUseCount;
+    std::atomic<uint32_t> FailedCount;
+
+    // Set slots for pool. Used by tNMEA0183MsgPoolT.
+    void SetStorage(tNMEA0183MsgPoolSlot *_Slots, uint16_t _SlotCount);
+    void Free(tNMEA0183MsgPoolSlot *Slot);
+
+  public:
+    tNMEA0183MsgPool(tNMEA0183MsgPoolSlot *_Slots=0, uint16_t _SlotCount=0);
+    // Take free slot. Message on slot has been cleared. Returns invalid handle, if pool is empty.
+    tNMEA0183MsgHandle Alloc();
+    // Take free slot and copy message to it.
+    tNMEA0183MsgHandle Alloc(const tNMEA0183Msg &NMEA0183Msg);
+    uint16_t Capacity() const { return SlotCount; }
+    uint16_t InUse() const { return InUseCount.load(std::memory_order_relaxed); }
+    // Count of failed allocations.
+    uint32_t Failed() const { return FailedCount.load(std::memory_order_relaxed); }
+};
+
+//------------------------------------------------------------------------------
+// Pool with slots inside object.
+template<uint16_t Count>
+class tNMEA0183MsgPoolT : public tNMEA0183MsgPool
+{
+  static_assert(Count>0 && Count<0xffff,"Invalid pool size");
+
+  protected:
+    tNMEA0183MsgPoolSlot Storage[Count];
+
+  public:
+    tNMEA0183MsgPoolT() { SetStorage(Storage,Count); }
+};
+
+#endif
+
+#endif
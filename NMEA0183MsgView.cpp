@@ -0,0 +1,208 @@
+/*
+NMEA0183MsgView.cpp
+
+Copyright (c) 2015-2019 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#include "NMEA0183MsgView.h"
+#include "NMEA0183Scan.h"
+
+// Data of empty view. Message code is at position 3, so it must be long enough for it.
+static const char EmptyData[4]={0,0,0,0};
+
+#ifndef ARDUINO
+extern "C" {
+// Current uptime in milliseconds. Must be implemented by application.
+extern uint32_t millis();
+}
+#endif
+
+//*****************************************************************************
+tNMEA0183MsgView::tNMEA0183MsgView() : Fields(DefaultFields), MaxFields(MAX_NMEA0183_MSG_FIELDS) {
+  Clear();
+}
+
+//*****************************************************************************
+tNMEA0183MsgView::tNMEA0183MsgView(const tNMEA0183Msg &NMEA0183Msg)
+: Fields(DefaultFields), MaxFields(MAX_NMEA0183_MSG_FIELDS) {
+  SetMessage(NMEA0183Msg);
+}
+
+//*****************************************************************************
+tNMEA0183MsgView::tNMEA0183MsgView(const tNMEA0183MsgView &NMEA0183Msg)
+: Fields(DefaultFields), MaxFields(MAX_NMEA0183_MSG_FIELDS) {
+  *this=NMEA0183Msg;
+}
+
+//*****************************************************************************
+// Views keep their own field storage. Too many fields clears the view.
+tNMEA0183MsgView &tNMEA0183MsgView::operator=(const tNMEA0183MsgView &NMEA0183Msg) {
+  if ( &NMEA0183Msg==this ) return *this;
+  if ( NMEA0183Msg._FieldCount>MaxFields ) { Clear(); return *this; }
+
+  Data=NMEA0183Msg.Data;
+  _MessageTime=NMEA0183Msg._MessageTime;
+  memcpy(Fields,NMEA0183Msg.Fields,NMEA0183Msg._FieldCount+1);
+  _FieldCount=NMEA0183Msg._FieldCount;
+  SenderPos=NMEA0183Msg.SenderPos;
+  CodeLen=NMEA0183Msg.CodeLen;
+  CheckSum=NMEA0183Msg.CheckSum;
+  Prefix=NMEA0183Msg.Prefix;
+  CodeId=NMEA0183Msg.CodeId;
+  _SenderId=NMEA0183Msg._SenderId;
+  SourceID=NMEA0183Msg.SourceID;
+
+  return *this;
+}
+
+//*****************************************************************************
+bool tNMEA0183MsgView::SetMessage(const tNMEA0183Msg &NMEA0183Msg) {
+  Clear();
+  if ( NMEA0183Msg.FieldCount()>MaxFields ) return false;
+
+  Data=NMEA0183Msg.Sender();
+  SenderPos=0;
+  CodeLen=strlen(NMEA0183Msg.MessageCode());
+  Prefix=NMEA0183Msg.GetPrefix();
+  CheckSum=NMEA0183Msg.GetCheckSum();
+  CodeId=NMEA0183Msg.MessageCodeId();
+  _SenderId=NMEA0183Msg.SenderId();
+  SourceID=NMEA0183Msg.SourceID;
+  _MessageTime=NMEA0183Msg.MessageTime();
+  _FieldCount=NMEA0183Msg.FieldCount();
+  for ( uint8_t i=0; i<_FieldCount; i++ ) {
+    Fields[i]=NMEA0183Msg.Field(i)-Data;
+  }
+  // Fields on tNMEA0183Msg are null separated, so end of last field is enough.
+  Fields[_FieldCount]=( _FieldCount>0
+                        ?Fields[_FieldCount-1]+NMEA0183Msg.FieldLen(_FieldCount-1)+1
+                        :3+CodeLen+1 );
+
+  return true;
+}
+
+//*****************************************************************************
+void tNMEA0183MsgView::Clear() {
+  Data=EmptyData;
+  _MessageTime=0;
+  Fields[0]=0;
+  _FieldCount=0;
+  SenderPos=0;
+  CodeLen=0;
+  CheckSum=0;
+  Prefix=' ';
+  CodeId=0;
+  _SenderId=0;
+  SourceID=0;
+}
+
+//*****************************************************************************
+bool tNMEA0183MsgView::SetMessage(const char *buf, size_t len) {
+  Clear();
+
+  // Shortest message is like $GPX,*hh. Field positions are stored as uint8_t.
+  if ( buf==0 || len<8 || len>0xff ) return false;
+  if ( buf[0]!='$' && buf[0]!='!' ) return false;
+
+  size_t Star=len-3;
+  if ( buf[Star]!='*' ) return false;
+  int csMsg=NMEA0183HexByte(buf+Star+1);
+  if ( csMsg<0 ) return false;
+
+  uint8_t cs=0;
+  size_t i=1;
+  uint8_t FieldCount=0;
+
+  for ( ; i<Star; ) {
+    tNMEA0183ScanMasks Masks;
+    size_t n=Star-i;
+    if ( n>NMEA0183_SCAN_BLOCK_LEN ) n=NMEA0183_SCAN_BLOCK_LEN;
+    NMEA0183ScanBlock(buf+i,n,Masks);
+    if ( Masks.CheckSum!=0 ) return false; // There must be only one '*'
+    cs=NMEA0183XorBytes(buf+i,n,cs);
+    for ( uint32_t Commas=Masks.Comma; Commas!=0; Commas&=Commas-1 ) {
+      if ( FieldCount>=MaxFields ) return false; // Too many fields
+      Fields[FieldCount]=i+__builtin_ctz(Commas)+1;
+      FieldCount++;
+    }
+    i+=n;
+  }
+
+  // Sender has two characters and message code at least one.
+  if ( FieldCount==0 || Fields[0]<5 ) return false;
+  if ( cs!=csMsg ) return false;
+
+  Data=buf;
+  SenderPos=1;
+  CodeLen=Fields[0]-1-3;
+  _FieldCount=FieldCount;
+  Fields[_FieldCount]=Star+1;
+  Prefix=buf[0];
+  CheckSum=cs;
+  _SenderId=NMEA0183SenderId(buf+SenderPos);
+  CodeId=NMEA0183MsgCodeId(buf+3,CodeLen);
+  _MessageTime=millis();
+
+  return true;
+}
+
+//*****************************************************************************
+// Fields on image are null terminated, so field ends are known without Data.
+bool tNMEA0183MsgView::SetImage(const char *Image, size_t len, char _Prefix, uint8_t _CheckSum, unsigned long MsgTime) {
+  Clear();
+
+  if ( Image==0 || len<5 || len>0xff || Image[2]!=0 || Image[len-1]!=0 ) return false;
+
+  const char *End=Image+len;
+  const char *p=(const char *)memchr(Image+3,0,len-3); // End of message code
+  uint8_t FieldCount=0;
+
+  for ( p++; p<End; p=(const char *)memchr(p,0,End-p)+1 ) {
+    if ( FieldCount>=MaxFields ) return false; // Too many fields
+    Fields[FieldCount]=p-Image;
+    FieldCount++;
+  }
+
+  Data=Image;
+  SenderPos=0;
+  CodeLen=( FieldCount>0 ? Fields[0] : len )-1-3;
+  _FieldCount=FieldCount;
+  Fields[_FieldCount]=len;
+  Prefix=_Prefix;
+  CheckSum=_CheckSum;
+  _SenderId=NMEA0183SenderId(Image);
+  CodeId=NMEA0183MsgCodeId(Image+3,CodeLen);
+  _MessageTime=MsgTime;
+
+  return true;
+}
+
+//*****************************************************************************
+size_t tNMEA0183MsgView::CopyField(uint8_t index, char *buf, size_t BufSize) const {
+  if ( buf==0 || BufSize==0 ) return 0;
+
+  size_t len=FieldLen(index);
+  if ( len>=BufSize ) len=BufSize-1;
+  memcpy(buf,Field(index),len);
+  buf[len]=0;
+
+  return len;
+}
@@ -0,0 +1,154 @@
+/*
+NMEA0183MsgView.h
+
+Copyright (c) 2015-2019 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+Non owning view to NMEA0183 message. View does not copy message data. It only
+keeps field positions on the original data, so the data must stay unchanged
+as long as view is used. View returned by tNMEA0183::GetMessage is valid until
+next call of GetMessage or ParseMessages.
+
+Note that fields on view are not null terminated. Field ends to ',', '*' or
+null. Use FieldLen to get field length.
+*/
+
+#ifndef _tNMEA0183MsgView_H_
+#define _tNMEA0183MsgView_H_
+
+#include "NMEA0183Msg.h"
+
+//------------------------------------------------------------------------------
+class tNMEA0183MsgView
+{
+  protected:
+    const char *Data;  // Start of data. Sender starts from SenderPos and message code from position 3.
+    unsigned long _MessageTime;
+    uint8_t *Fields;  // Field start positions. Fields[_FieldCount] is end of last field +1.
+    uint8_t MaxFields;
+    uint8_t _FieldCount;
+    uint8_t SenderPos;
+    uint8_t CodeLen;
+    uint8_t CheckSum;
+    char Prefix;
+    uint32_t CodeId;
+    uint16_t _SenderId;
+    uint8_t DefaultFields[MAX_NMEA0183_MSG_FIELDS+1];
+
+    // Set storage for field positions. Used by tNMEA0183MsgViewT. View will be cleared.
+    void SetStorage(uint8_t *_Fields, uint8_t _MaxFields) { Fields=_Fields; MaxFields=_MaxFields; Clear(); }
+
+  public:
+    uint8_t SourceID;  // This is used to separate messages e.g. from different ports. Receiver must set this.
+
+  public:
+    tNMEA0183MsgView();
+    // Set view to message. View is valid as long as NMEA0183Msg is unchanged. View will be
+    // empty, if message has more than MAX_NMEA0183_MSG_FIELDS fields. Use tNMEA0183MsgViewT for it.
+    tNMEA0183MsgView(const tNMEA0183Msg &NMEA0183Msg);
+    tNMEA0183MsgView(const tNMEA0183MsgView &NMEA0183Msg);
+    tNMEA0183MsgView &operator=(const tNMEA0183MsgView &NMEA0183Msg);
+    // Set view to message. Returns false and clears view, if message has more fields than view can hold.
+    bool SetMessage(const tNMEA0183Msg &NMEA0183Msg);
+    // Set view to received message buffer like "$HEHDT,244.71,T*1B". len is length of message including checksum.
+    // Returns true if checksum is OK.
+    bool SetMessage(const char *buf, size_t len);
+    // Set view to data image of message. See tNMEA0183Msg::Image. Image must stay unchanged
+    // as long as view is used. Returns false, if image is invalid or has too many fields.
+    bool SetImage(const char *Image, size_t len, char _Prefix, uint8_t _CheckSum, unsigned long MsgTime);
+    // Clear view
+    void Clear();
+    // Max count of fields.
+    uint8_t FieldCapacity() const { return MaxFields; }
+    // Return count of fields on message
+    uint8_t FieldCount() const { return _FieldCount; }
+    // Return pointer to field. Note that field is not null terminated.
+    const char *Field(uint8_t index) const { return (index<_FieldCount?Data+Fields[index]:""); }
+    // Return length of field
+    unsigned int FieldLen(uint8_t index) const { return (index<_FieldCount?Fields[index+1]-Fields[index]-1:0); }
+    // Return first character of field or 0 for empty field.
+    char FieldChar(uint8_t index) const { return (FieldLen(index)>0?Data[Fields[index]]:0); }
+    char GetPrefix() const { return Prefix; }
+    // Return pointer to sender code (like GP). Sender is always two characters and not null terminated.
+    const char *Sender() const { return Data+SenderPos; }
+    // Return pointer to message code (like GGA). Message code is not null terminated.
+    const char *MessageCode() const { return Data+3; }
+    unsigned int MessageCodeLen() const { return CodeLen; }
+    // Return checksum of message.
+    uint8_t GetCheckSum() const { return CheckSum; }
+    // Return packed ids of sender and message code. See NMEA0183MsgCodeId.
+    uint16_t SenderId() const { return _SenderId; }
+    uint32_t MessageCodeId() const { return CodeId; }
+    uint64_t MessageId() const { return NMEA0183MsgId(_SenderId,CodeId); }
+    // Check is message code given. For packable literal code this is integer compare.
+    bool IsMessageCode(const char* _code) const {
+      return ( NMEA0183MsgCodeId(_code)!=0
+               ? NMEA0183MsgCodeId(_code)==CodeId
+               : strncmp(MessageCode(),_code,CodeLen)==0 && _code[CodeLen]==0 );
+    }
+    bool IsMessageCodeId(uint32_t _CodeId) const { return _CodeId!=0 && _CodeId==CodeId; }
+    //
+    unsigned long MessageTime() const { return _MessageTime; }
+    // Copy field to buf with null termination. Field will be truncated to fit BufSize.
+    size_t CopyField(uint8_t index, char *buf, size_t BufSize) const;
+    // Typed field accessors. See tNMEA0183Msg::Get.
+    template <typename T> T Get(uint8_t index) const;
+    double GetLatLon(uint8_t index, uint8_t SignIndex) const {
+      double val;
+      return ( NMEA0183FieldToLatLon(Field(index),FieldLen(index),FieldChar(SignIndex),val)?val:NMEA0183DoubleNA );
+    }
+    double GetTime(uint8_t index) const {
+      double val;
+      return ( NMEA0183FieldToSeconds(Field(index),FieldLen(index),val)?val:NMEA0183DoubleNA );
+    }
+};
+
+//*****************************************************************************
+template <> inline double tNMEA0183MsgView::Get<double>(uint8_t index) const {
+  double val;
+  return ( NMEA0183FieldToDouble(Field(index),FieldLen(index),val)?val:NMEA0183DoubleNA );
+}
+
+//*****************************************************************************
+template <> inline int32_t tNMEA0183MsgView::Get<int32_t>(uint8_t index) const {
+  int32_t val;
+  return ( NMEA0183FieldToInt32(Field(index),FieldLen(index),val)?val:NMEA0183Int32NA );
+}
+
+//------------------------------------------------------------------------------
+// View with compile time field capacity for messages having more than
+// MAX_NMEA0183_MSG_FIELDS fields. See tNMEA0183MsgT.
+template <uint8_t MaxFieldCount>
+class tNMEA0183MsgViewT : public tNMEA0183MsgView
+{
+  static_assert(MaxFieldCount>=1 && MaxFieldCount<0xff,"Invalid field capacity");
+
+  protected:
+    uint8_t ExtFields[MaxFieldCount>MAX_NMEA0183_MSG_FIELDS?MaxFieldCount+1:1];
+
+    void InitStorage() { SetStorage(MaxFieldCount>MAX_NMEA0183_MSG_FIELDS?ExtFields:DefaultFields,MaxFieldCount); }
+
+  public:
+    tNMEA0183MsgViewT() { InitStorage(); }
+    tNMEA0183MsgViewT(const tNMEA0183Msg &NMEA0183Msg) { InitStorage(); SetMessage(NMEA0183Msg); }
+    tNMEA0183MsgViewT(const tNMEA0183MsgViewT &NMEA0183Msg) : tNMEA0183MsgView() { InitStorage(); *this=NMEA0183Msg; }
+    tNMEA0183MsgViewT &operator=(const tNMEA0183MsgViewT &NMEA0183Msg) { tNMEA0183MsgView::operator=(NMEA0183Msg); return *this; }
+};
+
+#endif
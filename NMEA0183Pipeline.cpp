@@ -0,0 +1,177 @@
+/*
+NMEA0183Pipeline.cpp
+
+Copyright (c) 2015-2019 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#if defined(__linux__)||defined(__linux)||defined(linux)
+
+#include <time.h>
+#include <unistd.h>
+#include <poll.h>
+#include "NMEA0183Pipeline.h"
+
+//*****************************************************************************
+tNMEA0183PipelineBase::tNMEA0183PipelineBase(tNMEA0183 *_NMEA0183, uint8_t _WorkerCount, tNMEA0183QueueFullPolicy _Policy)
+: NMEA0183(_NMEA0183), fd(-1), Policy(_Policy), Running(false), StartedThreads(0) {
+  if ( _WorkerCount<1 ) _WorkerCount=1;
+  if ( _WorkerCount>NMEA0183_PIPELINE_MAX_WORKERS ) _WorkerCount=NMEA0183_PIPELINE_MAX_WORKERS;
+  WorkerCount=_WorkerCount;
+  for ( uint8_t i=0; i<NMEA0183_PIPELINE_MAX_WORKERS; i++ ) {
+    Workers[i].Pipeline=this;
+    Workers[i].Index=i;
+    pthread_mutex_init(&Workers[i].Lock,0);
+    pthread_cond_init(&Workers[i].DataReady,0);
+    pthread_cond_init(&Workers[i].SpaceReady,0);
+    Workers[i].Sleeping=false;
+    Workers[i].Blocked=false;
+  }
+}
+
+//*****************************************************************************
+tNMEA0183PipelineBase::~tNMEA0183PipelineBase() {
+  Stop();
+  for ( uint8_t i=0; i<NMEA0183_PIPELINE_MAX_WORKERS; i++ ) {
+    pthread_cond_destroy(&Workers[i].SpaceReady);
+    pthread_cond_destroy(&Workers[i].DataReady);
+    pthread_mutex_destroy(&Workers[i].Lock);
+  }
+}
+
+//*****************************************************************************
+bool tNMEA0183PipelineBase::Start(int _fd) {
+  if ( NMEA0183==0 || StartedThreads>0 ) return false;
+
+  fd=_fd;
+  Running=true;
+  for ( uint8_t i=0; i<WorkerCount; i++ ) {
+    if ( pthread_create(&Workers[i].Thread,0,WorkerThreadMain,&Workers[i])!=0 ) { Stop(); return false; }
+    StartedThreads++;
+  }
+  if ( pthread_create(&IOThread,0,IOThreadMain,this)!=0 ) { Stop(); return false; }
+  StartedThreads++;
+
+  return true;
+}
+
+//*****************************************************************************
+// Workers are started first and I/O thread last, so StartedThreads tells which exist.
+void tNMEA0183PipelineBase::Stop() {
+  if ( StartedThreads==0 ) return;
+
+  Running=false;
+  if ( StartedThreads>WorkerCount ) pthread_join(IOThread,0);
+  for ( uint8_t i=0; i<StartedThreads && i<WorkerCount; i++ ) {
+    Wake(Workers[i],true);
+    pthread_join(Workers[i].Thread,0);
+  }
+  StartedThreads=0;
+}
+
+//*****************************************************************************
+void *tNMEA0183PipelineBase::IOThreadMain(void *Pipeline) {
+  ((tNMEA0183PipelineBase *)Pipeline)->ReadLoop();
+  return 0;
+}
+
+//*****************************************************************************
+void *tNMEA0183PipelineBase::WorkerThreadMain(void *Worker) {
+  tWorker *w=(tWorker *)Worker;
+  w->Pipeline->WorkLoop(*w);
+  return 0;
+}
+
+//*****************************************************************************
+// Waiting flag is set before checking queue under lock, and other side checks flag
+// after queue change. Fences make sure that at least one of them sees the other.
+void tNMEA0183PipelineBase::Wait(tWorker &Worker, bool ForData) {
+  std::atomic<bool> &Waiting=( ForData ? Worker.Sleeping : Worker.Blocked );
+  struct timespec Until;
+
+  clock_gettime(CLOCK_REALTIME,&Until);
+  Until.tv_nsec+=NMEA0183_PIPELINE_WAIT_MS*1000000L;
+  if ( Until.tv_nsec>=1000000000L ) { Until.tv_sec++; Until.tv_nsec-=1000000000L; }
+
+  pthread_mutex_lock(&Worker.Lock);
+  Waiting=true;
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  size_t Depth=Worker.Pipeline->QueueDepth(Worker.Index);
+  bool Ready=( ForData ? Depth>0 : Depth<Worker.Pipeline->QueueCapacity() );
+  if ( !Ready && Worker.Pipeline->Running ) {
+    pthread_cond_timedwait(( ForData ? &Worker.DataReady : &Worker.SpaceReady ),&Worker.Lock,&Until);
+  }
+  Waiting=false;
+  pthread_mutex_unlock(&Worker.Lock);
+}
+
+//*****************************************************************************
+void tNMEA0183PipelineBase::Wake(tWorker &Worker, bool ForData) {
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if ( !( ForData ? Worker.Sleeping : Worker.Blocked ) ) return;
+
+  pthread_mutex_lock(&Worker.Lock);
+  pthread_cond_signal(( ForData ? &Worker.DataReady : &Worker.SpaceReady ));
+  pthread_mutex_unlock(&Worker.Lock);
+}
+
+//*****************************************************************************
+void tNMEA0183PipelineBase::ReadLoop() {
+  const tNMEA0183Msg *NMEA0183Msg;
+
+  while ( Running ) {
+    if ( (NMEA0183Msg=ReadMessage())!=0 ) {
+      uint8_t i=( WorkerCount>1 ? NMEA0183Msg->MessageCodeId()%WorkerCount : 0 );
+      Push(Workers[i]);
+    } else if ( fd>=0 ) {
+      struct pollfd pfd={fd,POLLIN,0};
+      poll(&pfd,1,NMEA0183_PIPELINE_WAIT_MS);
+    } else {
+      usleep(NMEA0183_PIPELINE_WAIT_MS*1000);
+    }
+  }
+}
+
+//*****************************************************************************
+void tNMEA0183PipelineBase::Push(tWorker &Worker) {
+  while ( !PushMessage(Worker.Index) ) {
+    if ( Policy!=NMEA0183QueueBlock || !Running ) return;
+    Wait(Worker,false);
+  }
+  Wake(Worker,true);
+}
+
+//*****************************************************************************
+void tNMEA0183PipelineBase::WorkLoop(tWorker &Worker) {
+  const tNMEA0183Msg *NMEA0183Msg;
+
+  for ( ;; ) {
+    if ( (NMEA0183Msg=PopMessage(Worker.Index))!=0 ) {
+      Wake(Worker,false);
+      NMEA0183->DispatchMessage(*NMEA0183Msg);
+    } else if ( Running ) {
+      Wait(Worker,true);
+    } else {
+      break;
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,171 @@
+/*
+NMEA0183Pipeline.h
+
+Copyright (c) 2015-2019 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+Threaded receive pipeline for Linux. I/O thread frames and validates messages
+from tNMEA0183 and pushes them to lock-free queues. Worker threads pop messages
+and call handlers set for tNMEA0183, so slow handlers do not stall reading.
+With several workers messages are divided by message code, so messages of one
+type are always handled in received order by the same worker.
+
+Handlers will be called from worker threads. Do not change handlers or call
+ParseMessages or GetMessage for tNMEA0183, while pipeline is running.
+Queued messages have default capacity. For port with larger capacity use
+tNMEA0183PipelineT with same sizes, otherwise longer messages will be lost.
+
+Usage:
+  tNMEA0183LinuxStream Stream("/dev/ttyUSB0");
+  tNMEA0183 NMEA0183(&Stream);
+  tNMEA0183Pipeline Pipeline(&NMEA0183,2,NMEA0183QueueDropOldest);
+
+  NMEA0183.SetMsgHandler(HandleNMEA0183Msg);
+  NMEA0183.Open();
+  Pipeline.Start(Stream.Handle());
+*/
+
+#ifndef _tNMEA0183_PIPELINE_H_
+#define _tNMEA0183_PIPELINE_H_
+
+#if defined(__linux__)||defined(__linux)||defined(linux)
+
+#include <pthread.h>
+#include <atomic>
+#include "NMEA0183.h"
+#include "NMEA0183SPSCQueue.h"
+
+#ifndef NMEA0183_PIPELINE_QUEUE_SIZE
+#define NMEA0183_PIPELINE_QUEUE_SIZE 64
+#endif
+
+#ifndef NMEA0183_PIPELINE_MAX_WORKERS
+#define NMEA0183_PIPELINE_MAX_WORKERS 4
+#endif
+
+// Max time to wait without checking stop or lost wake up.
+#ifndef NMEA0183_PIPELINE_WAIT_MS
+#define NMEA0183_PIPELINE_WAIT_MS 10
+#endif
+
+//------------------------------------------------------------------------------
+// Threads and queue handling. Queues and messages are given by tNMEA0183PipelineT,
+// so that they have same capacity as port.
+class tNMEA0183PipelineBase
+{
+  protected:
+    struct tWorker {
+      tNMEA0183PipelineBase *Pipeline;
+      uint8_t Index;
+      pthread_t Thread;
+      pthread_mutex_t Lock;
+      pthread_cond_t DataReady;   // Signaled by I/O thread, when worker is sleeping
+      pthread_cond_t SpaceReady;  // Signaled by worker, when I/O thread is blocked
+      std::atomic<bool> Sleeping;
+      std::atomic<bool> Blocked;
+    };
+
+    tNMEA0183 *NMEA0183;
+    int fd;
+    tNMEA0183QueueFullPolicy Policy;
+    uint8_t WorkerCount;
+    tWorker Workers[NMEA0183_PIPELINE_MAX_WORKERS];
+    pthread_t IOThread;
+    std::atomic<bool> Running;
+    uint8_t StartedThreads;
+
+  protected:
+    static void *IOThreadMain(void *Pipeline);
+    static void *WorkerThreadMain(void *Worker);
+    void ReadLoop();
+    void WorkLoop(tWorker &Worker);
+    void Push(tWorker &Worker);
+    // Wait for data (worker) or space (I/O thread) on worker queue max NMEA0183_PIPELINE_WAIT_MS.
+    static void Wait(tWorker &Worker, bool ForData);
+    // Wake waiting worker or I/O thread.
+    static void Wake(tWorker &Worker, bool ForData);
+
+    // Read next message from port to I/O thread message. Returns 0, if there is no message.
+    virtual const tNMEA0183Msg *ReadMessage()=0;
+    // Push I/O thread message to worker queue. Returns false, if message was not queued.
+    virtual bool PushMessage(uint8_t Worker)=0;
+    // Pop next message from worker queue. Returns 0, if queue is empty.
+    virtual const tNMEA0183Msg *PopMessage(uint8_t Worker)=0;
+    virtual size_t QueueCapacity() const=0;
+
+    tNMEA0183PipelineBase(tNMEA0183 *_NMEA0183, uint8_t _WorkerCount, tNMEA0183QueueFullPolicy _Policy);
+
+  public:
+    // Derived class must call Stop, since threads use its queues.
+    virtual ~tNMEA0183PipelineBase();
+    // Start I/O and worker threads. If fd is given, I/O thread waits data with poll.
+    // Otherwise it sleeps NMEA0183_PIPELINE_WAIT_MS, when there is no data.
+    bool Start(int _fd=-1);
+    // Stop threads. Messages left on queues will be dispatched before stopping.
+    void Stop();
+    bool IsRunning() const { return Running.load(); }
+    uint8_t GetWorkerCount() const { return WorkerCount; }
+    // Queue statistics for worker.
+    virtual size_t QueueDepth(uint8_t Worker=0) const=0;
+    virtual size_t MaxQueueDepth(uint8_t Worker=0) const=0;
+    virtual uint32_t Dropped(uint8_t Worker=0) const=0;
+};
+
+//------------------------------------------------------------------------------
+// Pipeline for port with compile time message capacity. Use same MsgLen and
+// MaxFields as for port, so that long messages will not be lost on queue.
+// E.g. tNMEA0183PipelineT<200,40> for tNMEA0183T<200,1024,40>.
+template <uint8_t MsgLen, uint8_t MaxFields>
+class tNMEA0183PipelineT : public tNMEA0183PipelineBase
+{
+  protected:
+    typedef tNMEA0183MsgT<MsgLen,MaxFields> tMsg;
+    tNMEA0183SPSCQueue<tMsg,NMEA0183_PIPELINE_QUEUE_SIZE> Queues[NMEA0183_PIPELINE_MAX_WORKERS];
+    tMsg IOMsg;
+    tMsg WorkerMsgs[NMEA0183_PIPELINE_MAX_WORKERS];
+
+    virtual const tNMEA0183Msg *ReadMessage() { return ( NMEA0183->GetMessage(IOMsg) ? &IOMsg : 0 ); }
+    virtual bool PushMessage(uint8_t Worker) { return Queues[Worker].Push(IOMsg,Policy); }
+    virtual const tNMEA0183Msg *PopMessage(uint8_t Worker) {
+      return ( Queues[Worker].Pop(WorkerMsgs[Worker]) ? &WorkerMsgs[Worker] : 0 );
+    }
+    virtual size_t QueueCapacity() const { return NMEA0183_PIPELINE_QUEUE_SIZE; }
+
+  public:
+    tNMEA0183PipelineT(tNMEA0183 *_NMEA0183, uint8_t _WorkerCount=1, tNMEA0183QueueFullPolicy _Policy=NMEA0183QueueDropOldest)
+      : tNMEA0183PipelineBase(_NMEA0183,_WorkerCount,_Policy) {}
+    virtual ~tNMEA0183PipelineT() { Stop(); }
+
+    virtual size_t QueueDepth(uint8_t Worker=0) const { return ( Worker<WorkerCount ? Queues[Worker].Depth() : 0 ); }
+    virtual size_t MaxQueueDepth(uint8_t Worker=0) const { return ( Worker<WorkerCount ? Queues[Worker].MaxDepth() : 0 ); }
+    virtual uint32_t Dropped(uint8_t Worker=0) const { return ( Worker<WorkerCount ? Queues[Worker].Dropped() : 0 ); }
+};
+
+//------------------------------------------------------------------------------
+// Pipeline for tNMEA0183 or tNMEA0183T with default message capacity.
+class tNMEA0183Pipeline : public tNMEA0183PipelineT<MAX_NMEA0183_MSG_LEN,MAX_NMEA0183_MSG_FIELDS>
+{
+  public:
+    tNMEA0183Pipeline(tNMEA0183 *_NMEA0183, uint8_t _WorkerCount=1, tNMEA0183QueueFullPolicy _Policy=NMEA0183QueueDropOldest)
+      : tNMEA0183PipelineT<MAX_NMEA0183_MSG_LEN,MAX_NMEA0183_MSG_FIELDS>(_NMEA0183,_WorkerCount,_Policy) {}
+};
+
+#endif
+
+#endif
@@ -0,0 +1,203 @@
+/*
+NMEA0183Reactor.cpp
+
+Copyright (c) 2015-2019 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#if defined(__linux__)||defined(__linux)||defined(linux)
+
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
+#include <sys/epoll.h>
+#include "NMEA0183Reactor.h"
+
+//*****************************************************************************
+tNMEA0183Reactor::tNMEA0183Reactor() : Running(false) {
+  epfd=epoll_create1(EPOLL_CLOEXEC);
+  for ( int i=0; i<NMEA0183_REACTOR_MAX_PORTS; i++ ) Ports[i].NMEA0183=0;
+  for ( int i=0; i<NMEA0183_REACTOR_MAX_TIMERS; i++ ) Timers[i].Func=0;
+}
+
+//*****************************************************************************
+tNMEA0183Reactor::~tNMEA0183Reactor() {
+  if ( epfd!=-1 ) close(epfd);
+}
+
+//*****************************************************************************
+uint64_t tNMEA0183Reactor::Now() {
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC,&ts);
+
+  return (uint64_t)ts.tv_sec*1000+ts.tv_nsec/1000000;
+}
+
+//*****************************************************************************
+bool tNMEA0183Reactor::AddPort(tNMEA0183 *NMEA0183, int fd) {
+  if ( epfd==-1 || NMEA0183==0 || fd<0 ) return false;
+
+  for ( int i=0; i<NMEA0183_REACTOR_MAX_PORTS; i++ ) {
+    if ( Ports[i].NMEA0183!=0 ) continue;
+    struct epoll_event ev;
+    ev.events=EPOLLIN;
+    ev.data.u32=i;
+    if ( epoll_ctl(epfd,EPOLL_CTL_ADD,fd,&ev)!=0 ) return false;
+    Ports[i].NMEA0183=NMEA0183;
+    Ports[i].fd=fd;
+    Ports[i].WaitWrite=false;
+    return true;
+  }
+
+  return false;
+}
+
+//*****************************************************************************
+bool tNMEA0183Reactor::RemovePort(tNMEA0183 *NMEA0183) {
+  for ( int i=0; i<NMEA0183_REACTOR_MAX_PORTS; i++ ) {
+    if ( Ports[i].NMEA0183!=NMEA0183 || NMEA0183==0 ) continue;
+    epoll_ctl(epfd,EPOLL_CTL_DEL,Ports[i].fd,0);
+    Ports[i].NMEA0183=0;
+    return true;
+  }
+
+  return false;
+}
+
+//*****************************************************************************
+// Request writable event only while port has buffered data, since tty is
+// almost always writable.
+bool tNMEA0183Reactor::UpdateEvents(tPort &Port) {
+  bool WaitWrite=Port.NMEA0183->HasPendingOut();
+
+  if ( WaitWrite==Port.WaitWrite ) return true;
+
+  struct epoll_event ev;
+  ev.events=EPOLLIN;
+  if ( WaitWrite ) ev.events|=EPOLLOUT;
+  ev.data.u32=&Port-Ports;
+  if ( epoll_ctl(epfd,EPOLL_CTL_MOD,Port.fd,&ev)!=0 ) return false;
+  Port.WaitWrite=WaitWrite;
+
+  return true;
+}
+
+//*****************************************************************************
+int tNMEA0183Reactor::AddTimer(uint32_t PeriodMs, tTimerFunc Func, void *Context) {
+  if ( Func==0 || PeriodMs==0 ) return -1;
+
+  for ( int i=0; i<NMEA0183_REACTOR_MAX_TIMERS; i++ ) {
+    if ( Timers[i].Func!=0 ) continue;
+    Timers[i].Func=Func;
+    Timers[i].Context=Context;
+    Timers[i].Period=PeriodMs;
+    Timers[i].Next=Now()+PeriodMs;
+    return i;
+  }
+
+  return -1;
+}
+
+//*****************************************************************************
+bool tNMEA0183Reactor::RemoveTimer(int TimerId) {
+  if ( TimerId<0 || TimerId>=NMEA0183_REACTOR_MAX_TIMERS || Timers[TimerId].Func==0 ) return false;
+
+  Timers[TimerId].Func=0;
+
+  return true;
+}
+
+//*****************************************************************************
+int tNMEA0183Reactor::RunTimers() {
+  uint64_t now=Now();
+  int Count=0;
+
+  for ( int i=0; i<NMEA0183_REACTOR_MAX_TIMERS; i++ ) {
+    tTimer &Timer=Timers[i];
+    if ( Timer.Func==0 || Timer.Next>now ) continue;
+    // Keep period stable, but do not try to catch up missed periods.
+    Timer.Next+=Timer.Period;
+    if ( Timer.Next<=now ) Timer.Next=now+Timer.Period;
+    Timer.Func(Timer.Context);
+    Count++;
+  }
+
+  return Count;
+}
+
+//*****************************************************************************
+int tNMEA0183Reactor::NextTimerTimeout(int TimeoutMs) {
+  uint64_t now=Now();
+
+  for ( int i=0; i<NMEA0183_REACTOR_MAX_TIMERS; i++ ) {
+    if ( Timers[i].Func==0 ) continue;
+    uint64_t Wait=( Timers[i].Next>now ? Timers[i].Next-now : 0 );
+    if ( TimeoutMs<0 || Wait<(uint64_t)TimeoutMs ) TimeoutMs=(int)Wait;
+  }
+
+  return TimeoutMs;
+}
+
+//*****************************************************************************
+int tNMEA0183Reactor::Poll(int TimeoutMs) {
+  if ( epfd==-1 ) return -1;
+
+  // Ports may have got data to send since last poll.
+  for ( int i=0; i<NMEA0183_REACTOR_MAX_PORTS; i++ ) {
+    if ( Ports[i].NMEA0183!=0 ) UpdateEvents(Ports[i]);
+  }
+
+  struct epoll_event Events[NMEA0183_REACTOR_MAX_PORTS];
+  int n=epoll_wait(epfd,Events,NMEA0183_REACTOR_MAX_PORTS,NextTimerTimeout(TimeoutMs));
+  if ( n<0 ) return ( errno==EINTR ? 0 : -1 );
+
+  for ( int i=0; i<n; i++ ) {
+    uint32_t iPort=Events[i].data.u32;
+    if ( iPort>=NMEA0183_REACTOR_MAX_PORTS || Ports[iPort].NMEA0183==0 ) continue; // Removed by handler
+    tPort &Port=Ports[iPort];
+    // Hangup comes together with EPOLLIN, so data still buffered will be read before
+    // port will be removed.
+    if ( Events[i].events & EPOLLIN ) {
+      Port.NMEA0183->ParseMessages(); // Reads, frames and dispatches messages and sends buffered data
+    } else if ( Events[i].events & EPOLLOUT ) {
+      Port.NMEA0183->kick();
+    }
+    if ( Ports[iPort].NMEA0183==0 ) continue; // Removed by handler
+    if ( Events[i].events & (EPOLLERR | EPOLLHUP) ) { // Port has been closed
+      RemovePort(Port.NMEA0183);
+      continue;
+    }
+    UpdateEvents(Port);
+  }
+
+  return n+RunTimers();
+}
+
+//*****************************************************************************
+void tNMEA0183Reactor::Run() {
+  Running=true;
+
+  while ( Running ) {
+    if ( Poll()<0 ) break;
+  }
+}
+
+#endif
@@ -0,0 +1,104 @@
+/*
+NMEA0183Reactor.h
+
+Copyright (c) 2015-2019 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+Event loop for running several tNMEA0183 ports on Linux without busy polling.
+Reactor waits port file descriptors with epoll and calls ParseMessages only
+for ports, which have data to read, or kick for ports, which have buffered
+data and became writable. Periodic timers can be used for sending messages.
+
+Usage:
+  tNMEA0183LinuxStream Stream1("/dev/ttyUSB0");
+  tNMEA0183 NMEA0183_1(&Stream1);
+  tNMEA0183Reactor Reactor;
+
+  NMEA0183_1.SetMsgHandler(HandleNMEA0183Msg);
+  NMEA0183_1.Open();
+  Reactor.AddPort(&NMEA0183_1,Stream1.Handle());
+  Reactor.AddTimer(1000,SendRMC,&NMEA0183_1);
+  Reactor.Run();
+*/
+
+#ifndef _tNMEA0183_REACTOR_H_
+#define _tNMEA0183_REACTOR_H_
+
+#if defined(__linux__)||defined(__linux)||defined(linux)
+
+#include <stdint.h>
+#include "NMEA0183.h"
+
+#ifndef NMEA0183_REACTOR_MAX_PORTS
+#define NMEA0183_REACTOR_MAX_PORTS 16
+#endif
+
+#ifndef NMEA0183_REACTOR_MAX_TIMERS
+#define NMEA0183_REACTOR_MAX_TIMERS 8
+#endif
+
+//------------------------------------------------------------------------------
+class tNMEA0183Reactor
+{
+  public:
+    typedef void (*tTimerFunc)(void *Context);
+
+  protected:
+    struct tPort {
+      tNMEA0183 *NMEA0183;  // 0 for free slot
+      int fd;
+      bool WaitWrite;  // EPOLLOUT has been requested for port
+    };
+    struct tTimer {
+      tTimerFunc Func;  // 0 for free slot
+      void *Context;
+      uint32_t Period;
+      uint64_t Next;
+    };
+    int epfd;
+    bool Running;
+    tPort Ports[NMEA0183_REACTOR_MAX_PORTS];
+    tTimer Timers[NMEA0183_REACTOR_MAX_TIMERS];
+
+    static uint64_t Now();
+    bool UpdateEvents(tPort &Port);
+    int RunTimers();
+    int NextTimerTimeout(int TimeoutMs);
+
+  public:
+    tNMEA0183Reactor();
+    ~tNMEA0183Reactor();
+    // Add port to be waited. fd is file descriptor of port stream like tNMEA0183LinuxStream::Handle().
+    // Returns false, if there is no free slot or fd could not be added to epoll.
+    bool AddPort(tNMEA0183 *NMEA0183, int fd);
+    bool RemovePort(tNMEA0183 *NMEA0183);
+    // Add timer, which will be called every PeriodMs. Returns timer id or -1 on failure.
+    int AddTimer(uint32_t PeriodMs, tTimerFunc Func, void *Context=0);
+    bool RemoveTimer(int TimerId);
+    // Wait events max TimeoutMs (-1 waits until next timer or event) and handle them.
+    // Returns count of handled events and timers or -1 on error.
+    int Poll(int TimeoutMs=-1);
+    // Call Poll until Stop has been called.
+    void Run();
+    void Stop() { Running=false; }
+};
+
+#endif
+
+#endif
@@ -0,0 +1,148 @@
+/*
+NMEA0183SPSCQueue.h
+
+Copyright (c) 2015-2019 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+Lock-free single producer, single consumer queue with fixed capacity.
+Producer and consumer positions are on separate cache lines. Each slot has
+sequence number telling, whether it is free for producer or ready for consumer.
+When queue is full, producer can drop the newest item or take the oldest item
+away from consumer. Taking uses the same compare and swap as consumer, so slot
+data is never accessed by both at the same time.
+*/
+
+#ifndef _tNMEA0183_SPSC_QUEUE_H_
+#define _tNMEA0183_SPSC_QUEUE_H_
+
+#if !defined(__AVR__)
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+#include <utility>
+
+#ifndef NMEA0183_CACHE_LINE_SIZE
+#define NMEA0183_CACHE_LINE_SIZE 64
+#endif
+
+enum tNMEA0183QueueFullPolicy {
+  NMEA0183QueueBlock,       // Push fails and producer should wait
+  NMEA0183QueueDropOldest,  // Oldest item will be dropped
+  NMEA0183QueueDropNewest   // Pushed item will be dropped
+};
+
+//------------------------------------------------------------------------------
+template<class T, size_t Size>
+class tNMEA0183SPSCQueue
+{
+  protected:
+    struct tSlot {
+      std::atomic<size_t> Seq; // Pos for free slot, Pos+1 for ready item
+      T Item;
+    };
+
+    // Producer side
+    std::atomic<size_t> Head;
+    std::atomic<size_t> MaxDepthValue; // Written only by producer
+    std::atomic<uint32_t> DroppedCount;
+    char ProducerPad[NMEA0183_CACHE_LINE_SIZE];
+    // Consumer side. Producer touches this only when dropping the oldest item.
+    std::atomic<size_t> Tail;
+    char ConsumerPad[NMEA0183_CACHE_LINE_SIZE];
+    tSlot Slots[Size];
+
+    // Claim item at Tail. Returns false, if queue is empty.
+    bool Claim(size_t &Pos, tSlot *&Slot) {
+      Pos=Tail.load(std::memory_order_relaxed);
+      for ( ;; ) {
+        Slot=&Slots[Pos%Size];
+        size_t Seq=Slot->Seq.load(std::memory_order_acquire);
+        if ( Seq!=Pos+1 ) {
+          if ( (ptrdiff_t)(Seq-(Pos+1))<0 ) return false; // Empty
+          Pos=Tail.load(std::memory_order_relaxed);        // Tail moved
+        } else if ( Tail.compare_exchange_weak(Pos,Pos+1,std::memory_order_relaxed) ) {
+          return true;
+        }
+      }
+    }
+    // Give claimed slot back to producer.
+    void Release(size_t Pos, tSlot *Slot) { Slot->Seq.store(Pos+Size,std::memory_order_release); }
+
+  public:
+    tNMEA0183SPSCQueue() : Head(0), MaxDepthValue(0), DroppedCount(0), Tail(0) {
+      for ( size_t i=0; i<Size; i++ ) Slots[i].Seq.store(i,std::memory_order_relaxed);
+    }
+
+    // Called only by producer. Returns false, if item was not queued.
+    bool Push(const T &Item, tNMEA0183QueueFullPolicy Policy=NMEA0183QueueBlock) {
+      size_t Pos=Head.load(std::memory_order_relaxed);
+      tSlot *Slot=&Slots[Pos%Size];
+
+      while ( Slot->Seq.load(std::memory_order_acquire)!=Pos ) {
+        if ( Policy==NMEA0183QueueBlock ) return false;
+        if ( Policy==NMEA0183QueueDropNewest ) {
+          DroppedCount.fetch_add(1,std::memory_order_relaxed);
+          return false;
+        }
+        // Take the oldest item, which is on our slot. If consumer claimed it first,
+        // wait until it has released the slot.
+        size_t OldPos=Pos-Size;
+        if ( Tail.compare_exchange_strong(OldPos,OldPos+1,std::memory_order_relaxed) ) {
+          Release(Pos-Size,Slot);
+          DroppedCount.fetch_add(1,std::memory_order_relaxed);
+        }
+      }
+
+      Slot->Item=Item;
+      Slot->Seq.store(Pos+1,std::memory_order_release);
+      Head.store(Pos+1,std::memory_order_release);
+      size_t Depth=Pos+1-Tail.load(std::memory_order_relaxed);
+      if ( Depth>MaxDepthValue.load(std::memory_order_relaxed) && Depth<=Size ) MaxDepthValue.store(Depth,std::memory_order_relaxed);
+
+      return true;
+    }
+
+    // Called only by consumer. Returns false, if queue is empty.
+    bool Pop(T &Item) {
+      size_t Pos;
+      tSlot *Slot;
+
+      if ( !Claim(Pos,Slot) ) return false;
+      Item=std::move(Slot->Item); // Slot must not keep e.g. reference of tNMEA0183MsgHandle
+      Release(Pos,Slot);
+
+      return true;
+    }
+
+    bool IsEmpty() const { return Depth()==0; }
+    // Current count of queued items.
+    size_t Depth() const {
+      size_t Depth=Head.load(std::memory_order_relaxed)-Tail.load(std::memory_order_relaxed);
+      return ( Depth<=Size ? Depth : 0 );
+    }
+    // Highest depth seen by producer.
+    size_t MaxDepth() const { return MaxDepthValue.load(std::memory_order_relaxed); }
+    uint32_t Dropped() const { return DroppedCount.load(std::memory_order_relaxed); }
+    static size_t Capacity() { return Size; }
+};
+
+#endif
+
+#endif
@@ -0,0 +1,302 @@
+/*
+NMEA0183Scan.cpp
+
+Copyright (c) 2015-2019 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#include <string.h>
+#include "NMEA0183Scan.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define NMEA0183_SCAN_X86
+#include <immintrin.h>
+#include <atomic>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define NMEA0183_SCAN_NEON
+#include <arm_neon.h>
+#endif
+
+//*****************************************************************************
+static inline uint8_t ScanClass(char c) {
+  switch (c) {
+    case '$' :
+    case '!' : return NMEA0183Scan_Start;
+    case '*' : return NMEA0183Scan_CheckSum;
+    case ',' : return NMEA0183Scan_Comma;
+    case '\r' :
+    case '\n' : return NMEA0183Scan_LineEnd;
+    default : return 0;
+  }
+}
+
+#if defined(NMEA0183_SCAN_X86) || defined(NMEA0183_SCAN_NEON)
+//*****************************************************************************
+static inline uint32_t SelectMasks(const tNMEA0183ScanMasks &Masks, uint8_t Classes) {
+  uint32_t Mask=0;
+
+  if ( Classes & NMEA0183Scan_Start ) Mask|=Masks.Start;
+  if ( Classes & NMEA0183Scan_CheckSum ) Mask|=Masks.CheckSum;
+  if ( Classes & NMEA0183Scan_Comma ) Mask|=Masks.Comma;
+  if ( Classes & NMEA0183Scan_LineEnd ) Mask|=Masks.LineEnd;
+
+  return Mask;
+}
+#endif
+
+#if !defined(NMEA0183_SCAN_NEON)
+//*****************************************************************************
+static void ScanBlockScalar(const char *data, tNMEA0183ScanMasks &Masks) {
+  uint32_t Bit=1;
+
+  Masks.Start=0; Masks.CheckSum=0; Masks.Comma=0; Masks.LineEnd=0;
+
+  for ( uint8_t i=0; i<NMEA0183_SCAN_BLOCK_LEN; i++, Bit<<=1 ) {
+    switch ( ScanClass(data[i]) ) {
+      case NMEA0183Scan_Start : Masks.Start|=Bit; break;
+      case NMEA0183Scan_CheckSum : Masks.CheckSum|=Bit; break;
+      case NMEA0183Scan_Comma : Masks.Comma|=Bit; break;
+      case NMEA0183Scan_LineEnd : Masks.LineEnd|=Bit; break;
+    }
+  }
+}
+#endif
+
+#if defined(NMEA0183_SCAN_X86)
+//*****************************************************************************
+__attribute__((target("sse2")))
+static inline uint32_t MatchSSE2(__m128i lo, __m128i hi, char c1, char c2) {
+  __m128i v1=_mm_set1_epi8(c1);
+  __m128i v2=_mm_set1_epi8(c2);
+  uint32_t mlo=(uint32_t)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(lo,v1),_mm_cmpeq_epi8(lo,v2)));
+  uint32_t mhi=(uint32_t)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(hi,v1),_mm_cmpeq_epi8(hi,v2)));
+
+  return mlo | (mhi<<16);
+}
+
+//*****************************************************************************
+__attribute__((target("sse2")))
+static void ScanBlockSSE2(const char *data, tNMEA0183ScanMasks &Masks) {
+  __m128i lo=_mm_loadu_si128((const __m128i *)data);
+  __m128i hi=_mm_loadu_si128((const __m128i *)(data+16));
+
+  Masks.Start=MatchSSE2(lo,hi,'$','!');
+  Masks.CheckSum=MatchSSE2(lo,hi,'*','*');
+  Masks.Comma=MatchSSE2(lo,hi,',',',');
+  Masks.LineEnd=MatchSSE2(lo,hi,'\r','\n');
+}
+
+//*****************************************************************************
+__attribute__((target("avx2")))
+static inline uint32_t MatchAVX2(__m256i v, char c1, char c2) {
+  return (uint32_t)_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(v,_mm256_set1_epi8(c1)),
+                                                        _mm256_cmpeq_epi8(v,_mm256_set1_epi8(c2))));
+}
+
+//*****************************************************************************
+__attribute__((target("avx2")))
+static void ScanBlockAVX2(const char *data, tNMEA0183ScanMasks &Masks) {
+  __m256i v=_mm256_loadu_si256((const __m256i *)data);
+
+  Masks.Start=MatchAVX2(v,'$','!');
+  Masks.CheckSum=MatchAVX2(v,'*','*');
+  Masks.Comma=MatchAVX2(v,',',',');
+  Masks.LineEnd=MatchAVX2(v,'\r','\n');
+}
+
+typedef void (*tScanBlockFunc)(const char *data, tNMEA0183ScanMasks &Masks);
+
+static void ScanBlockSelect(const char *data, tNMEA0183ScanMasks &Masks);
+// Scanner is used from several threads, so selected kernel is stored atomically.
+// Constant initialization makes it valid also for static constructors.
+static std::atomic<tScanBlockFunc> ScanBlockFunc(ScanBlockSelect);
+
+//*****************************************************************************
+// Select best kernel for running CPU. Threads calling at the same time just
+// select the same kernel.
+static tScanBlockFunc SelectScanKernel() {
+  tScanBlockFunc Func;
+
+  __builtin_cpu_init();
+  if ( __builtin_cpu_supports("avx2") ) {
+    Func=ScanBlockAVX2;
+  } else if ( __builtin_cpu_supports("sse2") ) {
+    Func=ScanBlockSSE2;
+  } else {
+    Func=ScanBlockScalar;
+  }
+  ScanBlockFunc.store(Func,std::memory_order_relaxed);
+
+  return Func;
+}
+
+//*****************************************************************************
+// Kernel will be selected on first call.
+static void ScanBlockSelect(const char *data, tNMEA0183ScanMasks &Masks) {
+  SelectScanKernel()(data,Masks);
+}
+
+static inline void ScanFullBlock(const char *data, tNMEA0183ScanMasks &Masks) {
+  ScanBlockFunc.load(std::memory_order_relaxed)(data,Masks);
+}
+
+#elif defined(NMEA0183_SCAN_NEON)
+//*****************************************************************************
+static inline uint32_t MovemaskNEON(uint8x16_t v) {
+  static const uint8_t BitValues[16]={1,2,4,8,16,32,64,128,1,2,4,8,16,32,64,128};
+  uint8x16_t Bits=vandq_u8(v,vld1q_u8(BitValues));
+  uint8x8_t Sum=vpadd_u8(vget_low_u8(Bits),vget_high_u8(Bits));
+  Sum=vpadd_u8(Sum,Sum);
+  Sum=vpadd_u8(Sum,Sum);
+
+  return vget_lane_u16(vreinterpret_u16_u8(Sum),0);
+}
+
+//*****************************************************************************
+static inline uint32_t MatchNEON(uint8x16_t lo, uint8x16_t hi, char c1, char c2) {
+  uint8x16_t v1=vdupq_n_u8((uint8_t)c1);
+  uint8x16_t v2=vdupq_n_u8((uint8_t)c2);
+
+  return MovemaskNEON(vorrq_u8(vceqq_u8(lo,v1),vceqq_u8(lo,v2)))
+         | (MovemaskNEON(vorrq_u8(vceqq_u8(hi,v1),vceqq_u8(hi,v2)))<<16);
+}
+
+//*****************************************************************************
+static inline void ScanFullBlock(const char *data, tNMEA0183ScanMasks &Masks) {
+  uint8x16_t lo=vld1q_u8((const uint8_t *)data);
+  uint8x16_t hi=vld1q_u8((const uint8_t *)(data+16));
+
+  Masks.Start=MatchNEON(lo,hi,'$','!');
+  Masks.CheckSum=MatchNEON(lo,hi,'*','*');
+  Masks.Comma=MatchNEON(lo,hi,',',',');
+  Masks.LineEnd=MatchNEON(lo,hi,'\r','\n');
+}
+
+static const char *ScanKernel="neon";
+
+#else
+static inline void ScanFullBlock(const char *data, tNMEA0183ScanMasks &Masks) { ScanBlockScalar(data,Masks); }
+
+static const char *ScanKernel="scalar";
+#endif
+
+//*****************************************************************************
+void NMEA0183ScanBlock(const char *data, size_t len, tNMEA0183ScanMasks &Masks) {
+  if ( len>=NMEA0183_SCAN_BLOCK_LEN ) {
+    ScanFullBlock(data,Masks);
+  } else { // Partial block. Pad it with zeros, which does not belong to any class.
+    char Block[NMEA0183_SCAN_BLOCK_LEN];
+    memcpy(Block,data,len);
+    memset(Block+len,0,NMEA0183_SCAN_BLOCK_LEN-len);
+    ScanFullBlock(Block,Masks);
+  }
+}
+
+//*****************************************************************************
+const char *NMEA0183FindFirst(const char *data, const char *end, uint8_t Classes) {
+  #if defined(NMEA0183_SCAN_X86) || defined(NMEA0183_SCAN_NEON)
+  size_t len=end-data;
+
+  for ( size_t i=0; i<len; i+=NMEA0183_SCAN_BLOCK_LEN ) {
+    tNMEA0183ScanMasks Masks;
+    NMEA0183ScanBlock(data+i,len-i,Masks);
+    uint32_t Mask=SelectMasks(Masks,Classes);
+    if ( Mask!=0 ) return data+i+__builtin_ctz(Mask);
+  }
+  #else
+  // Without vector instructions plain byte loop is faster than building masks.
+  for ( ; data<end; data++ ) {
+    if ( ScanClass(*data) & Classes ) return data;
+  }
+  #endif
+
+  return 0;
+}
+
+//*****************************************************************************
+uint8_t NMEA0183XorBytes(const char *data, size_t len, uint8_t cs) {
+  #if !defined(__AVR__)
+  // XOR is bytewise, so we can xor whole words and fold result to byte at end.
+  uint64_t x=0;
+  for ( ; len>=8; data+=8, len-=8 ) {
+    uint64_t w;
+    memcpy(&w,data,8);
+    x^=w;
+  }
+  x^=x>>32; x^=x>>16; x^=x>>8;
+  cs^=(uint8_t)x;
+  #endif
+  for ( ; len>0; data++, len-- ) cs^=*data;
+
+  return cs;
+}
+
+#if defined(__AVR__)
+//*****************************************************************************
+static inline int HexValue(char c) {
+  if ( c>='0' && c<='9' ) return c-'0';
+  if ( c>='A' && c<='F' ) return c-'A'+10;
+  if ( c>='a' && c<='f' ) return c-'a'+10;
+  return -1;
+}
+#else
+#define X -1
+static const int8_t HexValues[256]={
+  X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
+  X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
+  X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
+  0,1,2,3,4,5,6,7,8,9,X,X,X,X,X,X,
+  X,10,11,12,13,14,15,X,X,X,X,X,X,X,X,X,
+  X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
+  X,10,11,12,13,14,15,X,X,X,X,X,X,X,X,X,
+  X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
+  X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
+  X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
+  X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
+  X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
+  X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
+  X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
+  X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,
+  X,X,X,X,X,X,X,X,X,X,X,X,X,X,X,X
+};
+#undef X
+
+static inline int HexValue(char c) { return HexValues[(uint8_t)c]; }
+#endif
+
+//*****************************************************************************
+int NMEA0183HexByte(const char *hex) {
+  int hi=HexValue(hex[0]);
+  int lo=HexValue(hex[1]);
+  if ( hi<0 || lo<0 ) return -1;
+
+  return (hi<<4) | lo;
+}
+
+//*****************************************************************************
+const char *NMEA0183ScanKernelName() {
+  #if defined(NMEA0183_SCAN_X86)
+  tScanBlockFunc Func=ScanBlockFunc.load(std::memory_order_relaxed);
+  if ( Func==ScanBlockSelect ) Func=SelectScanKernel();
+  return ( Func==ScanBlockAVX2 ? "avx2" : ( Func==ScanBlockSSE2 ? "sse2" : "scalar" ) );
+  #else
+  return ScanKernel;
+  #endif
+}
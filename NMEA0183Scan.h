@@ -0,0 +1,77 @@
+/*
+NMEA0183Scan.h
+
+Copyright (c) 2015-2019 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+Delimiter scanner for NMEA0183 data. Scanner finds message start, checksum,
+field separator and line end characters from blocks of data. On x86 SSE2 or
+AVX2 will be selected at run time. NEON will be used on ARM, if it is available
+at compile time. Other platforms use plain C++ code.
+
+Module has also checksum helpers, which are used together with scanner to
+handle message in one pass.
+*/
+
+#ifndef _tNMEA0183_SCAN_H_
+#define _tNMEA0183_SCAN_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define NMEA0183_SCAN_BLOCK_LEN 32
+
+// Character classes found by scanner
+enum tNMEA0183ScanClass {
+                          NMEA0183Scan_Start=0x01,    // '$' or '!'
+                          NMEA0183Scan_CheckSum=0x02, // '*'
+                          NMEA0183Scan_Comma=0x04,    // ','
+                          NMEA0183Scan_LineEnd=0x08   // '\r' or '\n'
+                        };
+
+// Bit n on mask is set, when data[n] belongs to the class.
+struct tNMEA0183ScanMasks {
+  uint32_t Start;
+  uint32_t CheckSum;
+  uint32_t Comma;
+  uint32_t LineEnd;
+};
+
+//*****************************************************************************
+// Scan max NMEA0183_SCAN_BLOCK_LEN bytes from data. Bits over len will be cleared.
+void NMEA0183ScanBlock(const char *data, size_t len, tNMEA0183ScanMasks &Masks);
+
+//*****************************************************************************
+// Returns pointer to first character between data and end belonging to any of
+// Classes (combination of tNMEA0183ScanClass) or 0, if there is none.
+const char *NMEA0183FindFirst(const char *data, const char *end, uint8_t Classes);
+
+//*****************************************************************************
+// Returns cs xored with len bytes from data. Data is handled 8 bytes at time.
+uint8_t NMEA0183XorBytes(const char *data, size_t len, uint8_t cs=0);
+
+//*****************************************************************************
+// Returns value of two hex digits like "1B" or "1b", or -1 if they are not valid.
+int NMEA0183HexByte(const char *hex);
+
+//*****************************************************************************
+// Returns name of used scan kernel: "scalar", "sse2", "avx2" or "neon".
+const char *NMEA0183ScanKernelName();
+
+#endif
@@ -30,6 +30,18 @@ I/O stream used in the NMEA0183 library.
 #ifdef ARDUINO
 // Arduino uses its own implementation.
 #else
+size_t tNMEA0183Stream::read(uint8_t *buf, size_t len) {
+   size_t i=0;
+
+   for ( ; i<len && available()>0; i++ ) {
+      int c=read();
+      if ( c<0 ) break;
+      buf[i]=(uint8_t)c;
+   }
+
+   return i;
+}
+
 size_t tNMEA0183Stream::print(const char *str) {
    if(str == 0)
       return 0;
@@ -29,6 +29,7 @@ I/O stream used in the NMEA2000 libraries.
 
 #include <stdint.h>
 #include <stddef.h>
+#include <limits.h>
 
 #ifdef ARDUINO
 // Arduino users get away with using the standard Stream class and its
@@ -42,9 +43,19 @@ typedef Stream tNMEA0183Stream;
 class tNMEA0183Stream {
    public:
    virtual int available() { return 1; }
-   virtual int availableForWrite() { return 1; }
+   // Count of bytes, which can be written without blocking. Default offers all
+   // data to write, so streams with limited output buffer should override this.
+   virtual int availableForWrite() { return INT_MAX; }
    // Returns first byte if incoming data, or -1 on no available data.
    virtual int read() = 0;
+   // Read up to len bytes of available data to buf. Returns count of bytes read.
+   // Default implementation reads byte by byte, so streams capable for bulk
+   // reading should override this.
+   virtual size_t read(uint8_t *buf, size_t len);
+   // Zero copy read for streams, which have data in memory. Sets data to point up
+   // to len bytes, which will be consumed and stay valid until next read. Returns
+   // count of bytes. Default sets data to 0, which means that read(buf,len) must be used.
+   virtual size_t readSpan(const uint8_t *&data, size_t len) { (void)len; data=0; return 0; }
 
    // Write data to stream.
    virtual size_t write(const uint8_t* data, size_t size) = 0;
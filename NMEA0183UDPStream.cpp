@@ -0,0 +1,266 @@
+/*
+NMEA0183UDPStream.cpp
+
+Copyright (c) 2015-2019 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#if defined(__linux__)||defined(__linux)||defined(linux)
+
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/socket.h>
+#include <sys/ioctl.h>
+#include <arpa/inet.h>
+#include "NMEA0183UDPStream.h"
+
+//*****************************************************************************
+tNMEA0183UDPStream::tNMEA0183UDPStream()
+: sock(-1), HasDestination(false), AutoFlush(true), RxCount(0), RxIndex(0), RxPos(0), TxCount(0) {
+  memset(&Destination,0,sizeof(Destination));
+  memset(&LastRxTime,0,sizeof(LastRxTime));
+  Tx[0].Len=0;
+}
+
+//*****************************************************************************
+tNMEA0183UDPStream::~tNMEA0183UDPStream() {
+  Close();
+}
+
+//*****************************************************************************
+void tNMEA0183UDPStream::CloseSocket() {
+  if ( sock!=-1 ) close(sock);
+  sock=-1;
+}
+
+//*****************************************************************************
+bool tNMEA0183UDPStream::Open(uint16_t LocalPort, const char *LocalAddress) {
+  Close();
+
+  sock=socket(AF_INET,SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC,0);
+  if ( sock==-1 ) return false;
+
+  int On=1;
+  setsockopt(sock,SOL_SOCKET,SO_REUSEADDR,&On,sizeof(On));
+  setsockopt(sock,SOL_SOCKET,SO_BROADCAST,&On,sizeof(On));
+  setsockopt(sock,SOL_SOCKET,SO_TIMESTAMPNS,&On,sizeof(On));
+
+  struct sockaddr_in Local;
+  memset(&Local,0,sizeof(Local));
+  Local.sin_family=AF_INET;
+  Local.sin_port=htons(LocalPort);
+  Local.sin_addr.s_addr=htonl(INADDR_ANY);
+  if ( LocalAddress!=0 && inet_pton(AF_INET,LocalAddress,&Local.sin_addr)!=1 ) { CloseSocket(); return false; }
+  if ( bind(sock,(struct sockaddr *)&Local,sizeof(Local))!=0 ) { CloseSocket(); return false; }
+
+  return true;
+}
+
+//*****************************************************************************
+void tNMEA0183UDPStream::Close() {
+  if ( sock!=-1 ) Flush();
+  CloseSocket();
+  RxCount=0; RxIndex=0; RxPos=0;
+  TxCount=0; Tx[0].Len=0;
+}
+
+//*****************************************************************************
+bool tNMEA0183UDPStream::JoinGroup(const char *Group, const char *Interface) {
+  struct ip_mreq Req;
+
+  if ( sock==-1 || Group==0 ) return false;
+  if ( inet_pton(AF_INET,Group,&Req.imr_multiaddr)!=1 ) return false;
+  Req.imr_interface.s_addr=htonl(INADDR_ANY);
+  if ( Interface!=0 && inet_pton(AF_INET,Interface,&Req.imr_interface)!=1 ) return false;
+
+  return setsockopt(sock,IPPROTO_IP,IP_ADD_MEMBERSHIP,&Req,sizeof(Req))==0;
+}
+
+//*****************************************************************************
+bool tNMEA0183UDPStream::SetDestination(const char *Address, uint16_t Port) {
+  HasDestination=false;
+  if ( Address==0 ) return false;
+
+  memset(&Destination,0,sizeof(Destination));
+  Destination.sin_family=AF_INET;
+  Destination.sin_port=htons(Port);
+  if ( inet_pton(AF_INET,Address,&Destination.sin_addr)!=1 ) return false;
+  HasDestination=true;
+
+  return true;
+}
+
+//*****************************************************************************
+// Receive all available datagrams up to batch size with one call.
+bool tNMEA0183UDPStream::ReceiveBatch() {
+  struct mmsghdr Msgs[NMEA0183_UDP_BATCH];
+  struct iovec Iov[NMEA0183_UDP_BATCH];
+  char Control[NMEA0183_UDP_BATCH][CMSG_SPACE(sizeof(struct timespec))];
+
+  RxCount=0; RxIndex=0; RxPos=0;
+  if ( sock==-1 ) return false;
+
+  memset(Msgs,0,sizeof(Msgs));
+  for ( int i=0; i<NMEA0183_UDP_BATCH; i++ ) {
+    Iov[i].iov_base=Rx[i].Data;
+    Iov[i].iov_len=NMEA0183_UDP_MAX_DATAGRAM;
+    Msgs[i].msg_hdr.msg_iov=&Iov[i];
+    Msgs[i].msg_hdr.msg_iovlen=1;
+    Msgs[i].msg_hdr.msg_control=Control[i];
+    Msgs[i].msg_hdr.msg_controllen=sizeof(Control[i]);
+  }
+
+  int n=recvmmsg(sock,Msgs,NMEA0183_UDP_BATCH,MSG_DONTWAIT,0);
+  if ( n<=0 ) return false;
+
+  for ( int i=0; i<n; i++ ) {
+    tDatagram &Datagram=Rx[i];
+    Datagram.Len=Msgs[i].msg_len;
+    // Datagram always ends line, so that framer will not combine it with next one.
+    if ( Datagram.Len>0 && Datagram.Data[Datagram.Len-1]!='\n' ) Datagram.Data[Datagram.Len++]='\n';
+    clock_gettime(CLOCK_REALTIME,&Datagram.Time);
+    for ( struct cmsghdr *cmsg=CMSG_FIRSTHDR(&Msgs[i].msg_hdr); cmsg!=0; cmsg=CMSG_NXTHDR(&Msgs[i].msg_hdr,cmsg) ) {
+      if ( cmsg->cmsg_level==SOL_SOCKET && cmsg->cmsg_type==SCM_TIMESTAMPNS ) {
+        memcpy(&Datagram.Time,CMSG_DATA(cmsg),sizeof(Datagram.Time));
+      }
+    }
+  }
+  RxCount=n;
+
+  return true;
+}
+
+//*****************************************************************************
+// Skip empty datagrams and receive next batch, when all has been read.
+bool tNMEA0183UDPStream::HasRxData() {
+  for ( ;; ) {
+    for ( ; RxIndex<RxCount; RxIndex++, RxPos=0 ) {
+      if ( RxPos<Rx[RxIndex].Len ) {
+        LastRxTime=Rx[RxIndex].Time;
+        return true;
+      }
+    }
+    if ( !ReceiveBatch() ) return false;
+  }
+}
+
+//*****************************************************************************
+int tNMEA0183UDPStream::available() {
+  if ( !HasRxData() ) return 0;
+
+  int Available=0;
+  for ( uint8_t i=RxIndex; i<RxCount; i++ ) Available+=Rx[i].Len;
+
+  return Available-RxPos;
+}
+
+//*****************************************************************************
+int tNMEA0183UDPStream::read() {
+  if ( !HasRxData() ) return -1;
+
+  return Rx[RxIndex].Data[RxPos++];
+}
+
+//*****************************************************************************
+// Returns data from one datagram at time.
+size_t tNMEA0183UDPStream::read(uint8_t *buf, size_t len) {
+  if ( !HasRxData() ) return 0;
+
+  tDatagram &Datagram=Rx[RxIndex];
+  size_t n=Datagram.Len-RxPos;
+  if ( n>len ) n=len;
+  memcpy(buf,Datagram.Data+RxPos,n);
+  RxPos+=n;
+
+  return n;
+}
+
+//*****************************************************************************
+int tNMEA0183UDPStream::availableForWrite() {
+  if ( !HasDestination ) return 0;
+  if ( TxCount>=NMEA0183_UDP_BATCH && !Flush() ) return 0;
+
+  return (NMEA0183_UDP_BATCH-TxCount)*NMEA0183_UDP_MAX_DATAGRAM-Tx[TxCount].Len;
+}
+
+//*****************************************************************************
+size_t tNMEA0183UDPStream::write(const uint8_t* data, size_t size) {
+  size_t Written=0;
+
+  if ( !HasDestination ) return 0;
+
+  while ( Written<size ) {
+    if ( TxCount>=NMEA0183_UDP_BATCH && !Flush() ) break;
+    tDatagram &Datagram=Tx[TxCount];
+    // Copy until line end or datagram is full.
+    size_t n=size-Written;
+    if ( n>(size_t)(NMEA0183_UDP_MAX_DATAGRAM-Datagram.Len) ) n=NMEA0183_UDP_MAX_DATAGRAM-Datagram.Len;
+    const uint8_t *LineEnd=(const uint8_t *)memchr(data+Written,'\n',n);
+    if ( LineEnd!=0 ) n=LineEnd-(data+Written)+1;
+    memcpy(Datagram.Data+Datagram.Len,data+Written,n);
+    Datagram.Len+=n;
+    Written+=n;
+    if ( LineEnd!=0 || Datagram.Len>=NMEA0183_UDP_MAX_DATAGRAM ) {
+      TxCount++;
+      if ( TxCount<NMEA0183_UDP_BATCH ) Tx[TxCount].Len=0;
+    }
+  }
+
+  if ( AutoFlush && TxCount>0 ) Flush();
+
+  return Written;
+}
+
+//*****************************************************************************
+bool tNMEA0183UDPStream::Flush() {
+  struct mmsghdr Msgs[NMEA0183_UDP_BATCH];
+  struct iovec Iov[NMEA0183_UDP_BATCH];
+
+  if ( TxCount==0 ) return true;
+  if ( sock==-1 || !HasDestination ) return false;
+
+  memset(Msgs,0,sizeof(Msgs));
+  for ( uint8_t i=0; i<TxCount; i++ ) {
+    Iov[i].iov_base=Tx[i].Data;
+    Iov[i].iov_len=Tx[i].Len;
+    Msgs[i].msg_hdr.msg_name=&Destination;
+    Msgs[i].msg_hdr.msg_namelen=sizeof(Destination);
+    Msgs[i].msg_hdr.msg_iov=&Iov[i];
+    Msgs[i].msg_hdr.msg_iovlen=1;
+  }
+
+  int n=sendmmsg(sock,Msgs,TxCount,MSG_DONTWAIT);
+  if ( n<=0 ) return false;
+
+  // Keep unsent datagrams and partially collected one.
+  uint8_t Left=TxCount-n;
+  if ( TxCount<NMEA0183_UDP_BATCH ) {
+    memmove(Tx,Tx+n,(Left+1)*sizeof(tDatagram));
+  } else {
+    memmove(Tx,Tx+n,Left*sizeof(tDatagram));
+    Tx[Left].Len=0;
+  }
+  TxCount=Left;
+
+  return TxCount==0;
+}
+
+#endif
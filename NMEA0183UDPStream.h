@@ -0,0 +1,112 @@
+/*
+NMEA0183UDPStream.h
+
+Copyright (c) 2015-2019 Timo Lappalainen, Kave Oy, www.kave.fi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+UDP stream for Linux. Stream can receive unicast, broadcast or multicast
+datagrams and send to unicast, broadcast or multicast destination. Datagrams
+are moved with recvmmsg/sendmmsg, so several datagrams are handled with one
+system call. Datagram boundaries are kept: read never combines data from two
+datagrams without line end between them. Kernel receive time of the datagram,
+which was read last, is available with RxTimestamp.
+
+Usage:
+  tNMEA0183UDPStream Stream;
+  Stream.Open(10110);                         // Receive on port 10110
+  Stream.JoinGroup("239.192.0.1");            // Optional multicast group
+  Stream.SetDestination("127.0.0.1",10111);   // Optional send destination
+  tNMEA0183 NMEA0183(&Stream);
+*/
+
+#ifndef _NMEA0183_UDP_STREAM_H_
+#define _NMEA0183_UDP_STREAM_H_
+
+#include "NMEA0183Stream.h"
+
+#if defined(__linux__)||defined(__linux)||defined(linux)
+
+#include <time.h>
+#include <netinet/in.h>
+
+// Max size of single NMEA0183 datagram.
+#ifndef NMEA0183_UDP_MAX_DATAGRAM
+#define NMEA0183_UDP_MAX_DATAGRAM 1472
+#endif
+
+// Count of datagrams handled with one system call.
+#ifndef NMEA0183_UDP_BATCH
+#define NMEA0183_UDP_BATCH 16
+#endif
+
+//-----------------------------------------------------------------------------
+class tNMEA0183UDPStream : public tNMEA0183Stream {
+protected:
+  struct tDatagram {
+    uint8_t Data[NMEA0183_UDP_MAX_DATAGRAM+1]; // Room for added line end
+    uint16_t Len;
+    struct timespec Time;
+  };
+  int sock;
+  struct sockaddr_in Destination;
+  bool HasDestination;
+  bool AutoFlush;
+  tDatagram Rx[NMEA0183_UDP_BATCH];
+  uint8_t RxCount;
+  uint8_t RxIndex;  // Datagram being read
+  uint16_t RxPos;   // Read position on datagram
+  struct timespec LastRxTime;
+  tDatagram Tx[NMEA0183_UDP_BATCH];
+  uint8_t TxCount;  // Datagrams ready to be sent. Tx[TxCount] collects next datagram.
+
+  bool ReceiveBatch();
+  bool HasRxData();
+  void CloseSocket();
+
+public:
+    tNMEA0183UDPStream();
+    virtual ~tNMEA0183UDPStream();
+    // Open socket and bind it to LocalPort for receiving. LocalPort 0 can be used for
+    // sending only. Returns false on error.
+    bool Open(uint16_t LocalPort=0, const char *LocalAddress=0);
+    void Close();
+    // Join multicast group. Interface 0 means default interface.
+    bool JoinGroup(const char *Group, const char *Interface=0);
+    // Set destination for sent data. Broadcast and multicast addresses are allowed.
+    bool SetDestination(const char *Address, uint16_t Port);
+    // With auto flush (default) each complete sentence will be sent immediately. Otherwise
+    // sentences will be collected until Flush is called or batch is full.
+    void SetAutoFlush(bool _AutoFlush) { AutoFlush=_AutoFlush; }
+    // Send collected datagrams. Returns false, if all could not be sent.
+    bool Flush();
+    int Handle() const { return sock; }
+    // Kernel receive time of datagram, which was read last.
+    const struct timespec &RxTimestamp() const { return LastRxTime; }
+
+    int available();
+    int availableForWrite();
+    int read();
+    size_t read(uint8_t *buf, size_t len);
+    using tNMEA0183Stream::write;
+    // Data will be sent as datagram, when line end has been written.
+    size_t write(const uint8_t* data, size_t size);
+};
+#endif
+
+#endif